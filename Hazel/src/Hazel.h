@@ -5,6 +5,7 @@
 #include "Hazel/Core/Application.h"
 #include "Hazel/Core/Layer.h"
 #include "Hazel/Core/Log.h"
+#include "Hazel/Core/JobSystem.h"
 
 #include "Hazel/Core/TimeStep.h"
 
@@ -15,6 +16,9 @@
 #include "Hazel/Renderer/PerspectiveCameraController.h"
 
 #include "Hazel/ImGui/ImGuiLayer.h"
+#include "Hazel/Debug/ProfilerPanel.h"
+#include "Hazel/Debug/FrameStats.h"
+#include "Hazel/Debug/FrameStatsPanel.h"
 
 #include "Hazel/Events/Event.h"
 #include "Hazel/Events/KeyEvent.h"
@@ -29,6 +33,9 @@
 #include "Hazel/Renderer/Shader.h"
 #include "Hazel/Renderer/Texture.h"
 #include "Hazel/Renderer/VertexArray.h"
+#include "Hazel/Renderer/Tilemap.h"
+#include "Hazel/Renderer/SubTexture2D.h"
+#include "Hazel/Renderer/TextureAtlas.h"
 
 #include "Hazel/Renderer/OrthographicCamera.h"
 #include "Hazel/Renderer/PerspectiveCamera.h"
@@ -1,17 +1,21 @@
 #include "hzpch.h"
 #include "Application.h"
 
-#include "Hazel/Core/log.h"
+#include "Hazel/Core/Log.h"
 #include "Hazel/Renderer/Renderer.h"
 #include "Hazel/Renderer/Renderer2D.h"
-#include "input.h"
+#include "Hazel/Renderer/TextureLoader.h"
+#include "Hazel/Renderer/RenderThread.h"
+#include "Hazel/Debug/FrameStats.h"
+#include "Hazel/Core/JobSystem.h"
+#include "Hazel/Core/Timer.h"
+#include "Hazel/Core/Input.h"
 #include "glm/glm.hpp"
-#include "KeyCodes.h"
 
-#include <GLFW/glfw3.h>
+#include <cmath>
+#include "KeyCodes.h"
 
 namespace Hazel {
-#define BIND_EVENT_FN(x) std::bind(&x, this, std::placeholders::_1)
 
 	Application* Application::s_Instance = nullptr;
 
@@ -21,10 +25,13 @@ namespace Hazel {
 
 		HZ_CORE_ASSERT(!s_Instance, "Application already exists!");
 		s_Instance = this;
+		m_StartTime = std::chrono::steady_clock::now();
 
 		m_Window = Scope<Window>(Window::Create(Hazel::WindowProps()));
-		m_Window->SetEventCallback(BIND_EVENT_FN(Application::OnEvent));
+		m_Window->SetEventCallback(HZ_BIND_EVENT_FN(QueueEvent));
+		Input::Init();
 
+		JobSystem::Init();
 		Renderer::Init();
 
 		m_ImGuiLayer = new ImGuiLayer();
@@ -33,7 +40,9 @@ namespace Hazel {
 	
 	Application::~Application()
 	{
-		Renderer2D::Shutdown();
+		FrameStats::Shutdown();
+		Renderer::Shutdown();
+		JobSystem::Shutdown();
 	}
 
 	void Application::PushLayer(Layer* layer)
@@ -50,12 +59,18 @@ namespace Hazel {
 		layer->OnAttach();
 	}
 
+	void Application::QueueEvent(Event& e)
+	{
+		m_EventQueue.Push(e);
+	}
+
 	void Application::OnEvent(Event& e)
 	{ 
 		HZ_PROFILE_FUNCTION();
-		EventDispacher dispacher(e);
-		dispacher.Dispach<WindowCloseEvent>(BIND_EVENT_FN(Application::OnWindowClose));
-		dispacher.Dispach<WindowResizeEvent>(BIND_EVENT_FN(Application::OnWindowResize));
+		static const EventHandlerTable<Application> s_Handlers = EventHandlerTable<Application>()
+			.On<WindowCloseEvent, &Application::OnWindowClose>()
+			.On<WindowResizeEvent, &Application::OnWindowResize>();
+		s_Handlers.Dispach(this, e);
 
 		for (auto it = m_LayerStack.end(); it != m_LayerStack.begin();)
 		{
@@ -70,30 +85,121 @@ namespace Hazel {
 		HZ_PROFILE_FUNCTION();
 		while (m_Running)
 		{
+			HZ_PROFILE_NEW_FRAME(); // starts and ends frame captures
 			HZ_PROFILE_SCOPE("Run Loop");
 
-			float time = (float)glfwGetTime();
-			TimeStep timestep = time - m_LastFrameTime;
+			if (m_RenderThreadEnabled != RenderThread::IsRunning())
+			{
+				if (m_RenderThreadEnabled)
+					RenderThread::Start(m_Window->GetContext());
+				else
+					RenderThread::Stop();
+			}
+
+			// keep absolute time in double, only the small per-frame delta goes to float
+			double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_StartTime).count();
+			double frameTime = time - m_LastFrameTime;
+			TimeStep timestep = (float)frameTime;
 			m_LastFrameTime = time;
 
+			FrameStats::BeginFrame();
+			Renderer::ResetStats(); // stats are reported per frame
+			Renderer2D::ResetStats();
+			TextureLoader::ProcessUploads();
+			JobSystem::ProcessMainThreadJobs();
+			m_EventQueue.Dispatch(HZ_BIND_EVENT_FN(OnEvent));
+
 			if (!m_Minimized)
 			{
 				HZ_PROFILE_SCOPE("Combined layer updates");
+				if (m_FixedTimeStep > 0.0)
+					FixedUpdate(frameTime);
 				{
 					HZ_PROFILE_SCOPE("Layer updates");
+					FrameStats::BeginGPUPass("Layers");
 					for (Layer* layer : m_LayerStack)
+					{
+						Timer timer;
 						layer->OnUpdate(timestep);
+						FrameStats::AddCPUTime(layer->GetName(), FrameStats::CPUSection::Update, timer.ElapsedMillis());
+					}
+					FrameStats::EndGPUPass();
 				}
 				m_ImGuiLayer->Begin();
 				{
 					HZ_PROFILE_SCOPE("ImGui layer updates");
 					for (Layer* layer : m_LayerStack)
+					{
+						Timer timer;
 						layer->OnImGuiRender();
+						FrameStats::AddCPUTime(layer->GetName(), FrameStats::CPUSection::ImGuiRender, timer.ElapsedMillis());
+					}
 				}
+				FrameStats::BeginGPUPass("ImGui");
 				m_ImGuiLayer->End();
+				FrameStats::EndGPUPass();
 			}
+			FrameStats::EndFrame(); // before the swap, which may block on vsync
 			m_Window->OnUpdate();
+			RenderThread::EndFrame();
+
+			if (++m_FrameCount == m_FrameLimit)
+				m_Running = false;
 		}
+
+		// everything after this, like releasing resources, happens on this thread again
+		RenderThread::Stop();
+
+		if (m_FrameLimit)
+			LogFrameSummary();
+	}
+
+	void Application::LogFrameSummary() const
+	{
+		FrameStats::Percentiles frame = FrameStats::GetPercentiles(&FrameStats::Frame::FrameTime);
+		FrameStats::Percentiles cpu = FrameStats::GetPercentiles(&FrameStats::Frame::CPUTime);
+		const FrameStats::Frame& last = FrameStats::GetFrame();
+
+		HZ_CORE_INFO("Ran {0} frames in {1:.3f} s ({2} in the history)", m_FrameCount, m_LastFrameTime, FrameStats::GetFrameCount());
+		HZ_CORE_INFO("  frame time p50 {0:.3f} ms, p95 {1:.3f} ms, p99 {2:.3f} ms", frame.P50, frame.P95, frame.P99);
+		HZ_CORE_INFO("  CPU time   p50 {0:.3f} ms, p95 {1:.3f} ms, p99 {2:.3f} ms", cpu.P50, cpu.P95, cpu.P99);
+		HZ_CORE_INFO("  last frame: {0} draw calls, {1} indices, {2} state changes ({3} skipped), {4} bytes uploaded",
+			last.DrawCalls, last.Indices, last.StateChanges, last.SkippedStateChanges, last.UploadedBytes);
+	}
+
+	void Application::SetFixedTimeStep(double step, uint32_t maxStepsPerFrame)
+	{
+		HZ_CORE_ASSERT(step >= 0.0, "Fixed time step cannot be negative!");
+		HZ_CORE_ASSERT(maxStepsPerFrame > 0, "At least one fixed step per frame is needed!");
+		m_FixedTimeStep = step;
+		m_MaxFixedStepsPerFrame = maxStepsPerFrame;
+		m_FixedAccumulator = 0.0;
+		m_FixedUpdateAlpha = 0.0f;
+	}
+
+	void Application::FixedUpdate(double frameTime)
+	{
+		HZ_PROFILE_FUNCTION();
+		m_FixedAccumulator += frameTime;
+
+		uint32_t steps = 0;
+		while (m_FixedAccumulator >= m_FixedTimeStep && steps < m_MaxFixedStepsPerFrame)
+		{
+			for (Layer* layer : m_LayerStack)
+			{
+				Timer timer;
+				layer->OnFixedUpdate((float)m_FixedTimeStep);
+				FrameStats::AddCPUTime(layer->GetName(), FrameStats::CPUSection::FixedUpdate, timer.ElapsedMillis());
+			}
+			m_FixedAccumulator -= m_FixedTimeStep;
+			steps++;
+		}
+
+		// could not keep up, let the simulation fall behind rather than trying to catch up forever
+		if (m_FixedAccumulator >= m_FixedTimeStep)
+			m_FixedAccumulator = std::fmod(m_FixedAccumulator, m_FixedTimeStep);
+
+		m_FixedUpdateAlpha = (float)(m_FixedAccumulator / m_FixedTimeStep);
 	}
 
 	 bool Application::OnWindowClose(WindowCloseEvent& e)
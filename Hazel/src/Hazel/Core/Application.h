@@ -3,10 +3,13 @@
 #include "Hazel/Core/LayerStack.h"
 #include "Hazel/Events/Event.h"
 #include "Hazel/Events/ApplicationEvent.h"
+#include "Hazel/Events/EventQueue.h"
 
 #include "Hazel/ImGui/ImGuiLayer.h"
 #include "Hazel/Core/TimeStep.h"
 
+#include <chrono>
+
 namespace Hazel {
 
 	class Application
@@ -22,18 +25,52 @@ namespace Hazel {
 		void PushLayer(Layer* layer);
 		void PushOverlay(Layer* layer);
 
+		// Runs Layer::OnFixedUpdate every step seconds of simulated time, before OnUpdate.
+		// At most maxStepsPerFrame steps run per frame, time beyond that is dropped
+		// instead of snowballing. A step of 0 turns the fixed update off (the default).
+		void SetFixedTimeStep(double step, uint32_t maxStepsPerFrame = 8);
+		inline double GetFixedTimeStep() const { return m_FixedTimeStep; }
+		// How far the current frame is past the last fixed step, in [0, 1), to interpolate
+		// between the previous and the current simulation state when rendering
+		inline float GetFixedUpdateAlpha() const { return m_FixedUpdateAlpha; }
+		// seconds since the application was created
+		inline double GetTime() const { return m_LastFrameTime; }
+
+		// Stops Run after this many frames and logs a summary of their timings, for benchmarks.
+		// 0 runs until the window is closed (the default).
+		inline void SetFrameLimit(uint64_t frames) { m_FrameLimit = frames; }
+
+		// Renders on a RenderThread that replays the last frame while the next one is recorded.
+		// Off by default, the switch happens at the start of the next frame.
+		inline void SetRenderThreadEnabled(bool enabled) { m_RenderThreadEnabled = enabled; }
+		inline bool IsRenderThreadEnabled() const { return m_RenderThreadEnabled; }
+
 		inline static Application& Get() { return *s_Instance; }
 		inline Window& GetWindow() { return *m_Window; }
 	private:
+		void QueueEvent(Event& e);
 		bool OnWindowClose(WindowCloseEvent& e);
 		bool OnWindowResize(WindowResizeEvent& e);
+
+		void FixedUpdate(double frameTime);
+		void LogFrameSummary() const;
 	private:
 		Scope<Window> m_Window;
 		ImGuiLayer* m_ImGuiLayer;
 		bool m_Running = true;
 		bool m_Minimized = false;
+		bool m_RenderThreadEnabled = false;
 		LayerStack m_LayerStack;
-		float m_LastFrameTime = 0.0f;
+		EventQueue m_EventQueue;
+		double m_LastFrameTime = 0.0;
+		std::chrono::steady_clock::time_point m_StartTime;
+		uint64_t m_FrameCount = 0;
+		uint64_t m_FrameLimit = 0;
+
+		double m_FixedTimeStep = 0.0;
+		uint32_t m_MaxFixedStepsPerFrame = 8;
+		double m_FixedAccumulator = 0.0;
+		float m_FixedUpdateAlpha = 0.0f;
 
 		static Application* s_Instance;
 	};
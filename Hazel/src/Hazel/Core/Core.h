@@ -38,8 +38,10 @@
 	#define HZ_PLATFORM_ANDROID
 	#error "Andoid is not supported!"
 #elif defined(__linux__)
-	#define HZ_PLATFORM_LINUX
-	#error "Linux is not supported!"
+	// headless builds only, see RendererAPI::API::Null
+	#ifndef HZ_PLATFORM_LINUX
+		#define HZ_PLATFORM_LINUX
+	#endif
 #else
 	/* Unknown compiler / platform */
 	#error "Unknown platform!"
@@ -61,8 +63,8 @@
 
 
 #ifdef HZ_ENABLE_ASSERTS
-	#define HZ_ASSERT(x, ...) {if(!(x)) { HZ_ERROR("Assertion Failed: {0}", __VA_ARGS__); __debugbreak(); } }
-	#define HZ_CORE_ASSERT(x, ...) {if(!(x)) { HZ_CORE_ERROR("Assertion Failed: {0}", __VA_ARGS__); __debugbreak(); } }
+	#define HZ_ASSERT(x, ...) {if(!(x)) { HZ_ERROR("Assertion Failed: {0}", __VA_ARGS__); HZ_DEBUGBREAK(); } }
+	#define HZ_CORE_ASSERT(x, ...) {if(!(x)) { HZ_CORE_ERROR("Assertion Failed: {0}", __VA_ARGS__); HZ_DEBUGBREAK(); } }
 #else
 	#define HZ_ASSERT(x, ...)
 	#define HZ_CORE_ASSERT(x, ...)
@@ -70,7 +72,8 @@
 
 #define BIT(x) (1 << x)
 
-#define HZ_BIND_EVENT_FN(fn) std::bind(&fn, this, std::placeholders::_1)
+// binds a member function of this by its unqualified name, e.g. HZ_BIND_EVENT_FN(OnEvent)
+#define HZ_BIND_EVENT_FN(fn) [this](auto&&... args) -> decltype(auto) { return this->fn(std::forward<decltype(args)>(args)...); }
 
 namespace Hazel {
 
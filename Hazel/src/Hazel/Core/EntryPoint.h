@@ -1,7 +1,8 @@
 #pragma once
 #include "Hazel/Core/Core.h"
+#include "Hazel/Renderer/RendererAPI.h"
 
-#ifdef HZ_PLATFORM_WINDOWS
+#if defined(HZ_PLATFORM_WINDOWS) || defined(HZ_PLATFORM_LINUX)
 
 extern Hazel::Application* Hazel::CreateApplication();
 
@@ -10,17 +11,35 @@ int main(int argc, char** argv)
 	Hazel::Log::Init();
 	HZ_CORE_INFO("Log init");
 
-	HZ_PROFILE_BEGIN_SESSION("Startup", "HazelProfile-Startup.json");
+	// --profile records the whole run, otherwise frames are captured on demand
+	// --headless renders with the null backend, without a window or GPU
+	// --frames N quits after N frames and logs their timings
+	bool profile = false;
+	uint64_t frames = 0;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		if (arg == "--profile")
+			profile = true;
+		else if (arg == "--headless")
+			Hazel::RendererAPI::SetAPI(Hazel::RendererAPI::API::Null);
+		else if (arg == "--frames" && i + 1 < argc)
+			frames = std::strtoull(argv[++i], nullptr, 10);
+	}
+
+	if (profile) HZ_PROFILE_BEGIN_SESSION("Startup", "HazelProfile-Startup.hztrace");
 	auto app = Hazel::CreateApplication();
-	HZ_PROFILE_END_SESSION();
+	if (profile) HZ_PROFILE_END_SESSION();
+
+	app->SetFrameLimit(frames);
 
-	HZ_PROFILE_BEGIN_SESSION("Runtime", "HazelProfile-Runtime.json");
+	if (profile) HZ_PROFILE_BEGIN_SESSION("Runtime", "HazelProfile-Runtime.hztrace");
 	app->Run();
-	HZ_PROFILE_END_SESSION();
+	if (profile) HZ_PROFILE_END_SESSION();
 	
-	HZ_PROFILE_BEGIN_SESSION("Shutdown", "HazelProfile-Shutdown.json");
+	if (profile) HZ_PROFILE_BEGIN_SESSION("Shutdown", "HazelProfile-Shutdown.hztrace");
 	delete app;
-	HZ_PROFILE_END_SESSION();
+	if (profile) HZ_PROFILE_END_SESSION();
 }
 
-#endif // HZ_PLATFORM_WINDOWS
\ No newline at end of file
+#endif // HZ_PLATFORM_WINDOWS || HZ_PLATFORM_LINUX
\ No newline at end of file
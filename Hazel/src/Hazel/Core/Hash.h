@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+
+namespace Hazel {
+
+	namespace Hash {
+
+		// 32 bit FNV-1a, constexpr so strings known at compile time can be hashed ahead of time
+		constexpr uint32_t FNV1a(const char* str, size_t length)
+		{
+			uint32_t hash = 2166136261u;
+			for (size_t i = 0; i < length; i++)
+			{
+				hash ^= (uint8_t)str[i];
+				hash *= 16777619u;
+			}
+			return hash;
+		}
+
+		constexpr uint32_t FNV1a(const char* str)
+		{
+			size_t length = 0;
+			while (str[length] != '\0')
+				length++;
+			return FNV1a(str, length);
+		}
+
+		inline uint32_t FNV1a(const std::string& str)
+		{
+			return FNV1a(str.c_str(), str.size());
+		}
+
+		// 64 bit variant, pass the previous result as seed to hash several strings in a row
+		constexpr uint64_t FNV1a64(const char* str, size_t length, uint64_t seed = 14695981039346656037ull)
+		{
+			uint64_t hash = seed;
+			for (size_t i = 0; i < length; i++)
+			{
+				hash ^= (uint8_t)str[i];
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+
+		inline uint64_t FNV1a64(const std::string& str, uint64_t seed = 14695981039346656037ull)
+		{
+			return FNV1a64(str.c_str(), str.size(), seed);
+		}
+
+	}
+
+}
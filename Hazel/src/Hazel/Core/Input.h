@@ -5,6 +5,11 @@ namespace Hazel {
 	class Input
 	{
 	public:
+		virtual ~Input() = default;
+
+		// picks the implementation matching the window, called by the Application once it has one
+		static void Init();
+
 		inline static bool IsKeyPressed(int keycode) { return s_Instance->IsKeyPressedImpl(keycode); }
 		inline static bool IsMouseButtonPressed(int button) { return s_Instance->IsMouseButtonPressedImpl(button); }
 
@@ -18,7 +23,7 @@ namespace Hazel {
 		virtual float GetMouseYImpl() = 0;
 		virtual std::pair<float, float> GetMousePositionImpl() = 0;
 	private:
-		static Input* s_Instance;
+		static Scope<Input> s_Instance;
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,236 @@
+#include "hzpch.h"
+#include "JobSystem.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace Hazel {
+
+	struct Job
+	{
+		JobSystem::JobFn Function;
+		JobCounter* Counter;
+	};
+
+	struct JobQueue
+	{
+		std::mutex Mutex;
+		std::deque<Job> Jobs;
+	};
+
+	struct JobSystemData
+	{
+		std::vector<std::thread> Workers;
+		// one per worker, the last one takes jobs submitted from any other thread
+		std::vector<Scope<JobQueue>> Queues;
+
+		std::atomic<bool> Running = false;
+		std::atomic<uint32_t> QueuedJobs = 0;
+		std::mutex SleepMutex;
+		std::condition_variable SleepCondition;
+
+		std::mutex MainThreadMutex;
+		std::vector<JobSystem::JobFn> MainThreadJobs;
+		std::thread::id MainThreadID;
+	};
+
+	static JobSystemData s_Data;
+	static thread_local uint32_t t_QueueIndex = UINT32_MAX; // UINT32_MAX: not a worker
+
+	static uint32_t GetSubmitQueueIndex()
+	{
+		return t_QueueIndex != UINT32_MAX ? t_QueueIndex : (uint32_t)s_Data.Queues.size() - 1;
+	}
+
+	// newest job of our own queue, or the oldest one of somebody else's
+	static bool PopJob(Job& job)
+	{
+		uint32_t self = GetSubmitQueueIndex();
+		uint32_t count = (uint32_t)s_Data.Queues.size();
+		for (uint32_t i = 0; i < count; i++)
+		{
+			uint32_t index = (self + i) % count;
+			JobQueue& queue = *s_Data.Queues[index];
+			std::lock_guard<std::mutex> lock(queue.Mutex);
+			if (queue.Jobs.empty())
+				continue;
+
+			if (index == self)
+			{
+				job = std::move(queue.Jobs.back());
+				queue.Jobs.pop_back();
+			}
+			else
+			{
+				job = std::move(queue.Jobs.front());
+				queue.Jobs.pop_front();
+			}
+			s_Data.QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+		return false;
+	}
+
+	bool JobSystem::TryRunJob()
+	{
+		Job job;
+		if (!PopJob(job))
+			return false;
+
+		job.Function();
+		if (job.Counter)
+			job.Counter->m_Value.fetch_sub(1, std::memory_order_release);
+		return true;
+	}
+
+	void JobSystem::WorkerLoop(uint32_t index)
+	{
+		t_QueueIndex = index;
+		while (true)
+		{
+			if (TryRunJob())
+				continue;
+
+			// a job still running elsewhere may queue more, it is run by that same worker
+			if (!s_Data.Running.load(std::memory_order_acquire) && s_Data.QueuedJobs.load(std::memory_order_relaxed) == 0)
+				break;
+
+			std::unique_lock<std::mutex> lock(s_Data.SleepMutex);
+			s_Data.SleepCondition.wait(lock, []()
+			{
+				return !s_Data.Running.load(std::memory_order_acquire) || s_Data.QueuedJobs.load(std::memory_order_relaxed) > 0;
+			});
+		}
+	}
+
+	void JobSystem::Init(uint32_t workerCount)
+	{
+		HZ_PROFILE_FUNCTION();
+		HZ_CORE_ASSERT(!s_Data.Running, "JobSystem already initialized!");
+
+		if (workerCount == 0)
+			workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+		s_Data.MainThreadID = std::this_thread::get_id();
+		for (uint32_t i = 0; i < workerCount + 1; i++)
+			s_Data.Queues.push_back(CreateScope<JobQueue>());
+
+		s_Data.Running = true;
+		for (uint32_t i = 0; i < workerCount; i++)
+			s_Data.Workers.emplace_back(WorkerLoop, i);
+
+		HZ_CORE_INFO("JobSystem started {0} workers", workerCount);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		HZ_PROFILE_FUNCTION();
+		{
+			std::lock_guard<std::mutex> lock(s_Data.SleepMutex);
+			s_Data.Running = false;
+		}
+		s_Data.SleepCondition.notify_all();
+
+		// the workers drain the queues before they exit, this thread helps out
+		while (TryRunJob())
+			;
+		for (std::thread& worker : s_Data.Workers)
+			worker.join();
+
+		s_Data.Workers.clear();
+		s_Data.Queues.clear();
+		s_Data.QueuedJobs = 0;
+		s_Data.MainThreadJobs.clear();
+	}
+
+	void JobSystem::Run(JobFn job, JobCounter* counter)
+	{
+		if (s_Data.Queues.empty())
+		{
+			HZ_CORE_ASSERT(false, "JobSystem is not initialized!");
+			job();
+			return;
+		}
+
+		if (counter)
+			counter->m_Value.fetch_add(1, std::memory_order_relaxed);
+
+		JobQueue& queue = *s_Data.Queues[GetSubmitQueueIndex()];
+		{
+			std::lock_guard<std::mutex> lock(queue.Mutex);
+			queue.Jobs.push_back({ std::move(job), counter });
+		}
+		s_Data.QueuedJobs.fetch_add(1, std::memory_order_relaxed);
+
+		// taking the lock orders this with a worker checking the count and going to sleep
+		{
+			std::lock_guard<std::mutex> lock(s_Data.SleepMutex);
+		}
+		s_Data.SleepCondition.notify_one();
+	}
+
+	void JobSystem::Wait(const JobCounter& counter)
+	{
+		HZ_PROFILE_FUNCTION();
+		while (!counter.IsDone())
+		{
+			if (!TryRunJob())
+				std::this_thread::yield();
+		}
+	}
+
+	void JobSystem::ParallelFor(uint32_t count, uint32_t batchSize, const RangeFn& func)
+	{
+		HZ_PROFILE_FUNCTION();
+		if (count == 0)
+			return;
+
+		batchSize = std::max(batchSize, 1u);
+		if (count <= batchSize)
+		{
+			func(0, count);
+			return;
+		}
+
+		JobCounter counter;
+		for (uint32_t begin = 0; begin < count; begin += batchSize)
+		{
+			uint32_t end = std::min(begin + batchSize, count);
+			Run([&func, begin, end]() { func(begin, end); }, &counter);
+		}
+		Wait(counter);
+	}
+
+	void JobSystem::RunOnMainThread(JobFn job)
+	{
+		std::lock_guard<std::mutex> lock(s_Data.MainThreadMutex);
+		s_Data.MainThreadJobs.push_back(std::move(job));
+	}
+
+	void JobSystem::ProcessMainThreadJobs()
+	{
+		HZ_PROFILE_FUNCTION();
+		HZ_CORE_ASSERT(IsMainThread(), "Main thread jobs have to run on the main thread!");
+
+		std::vector<JobFn> jobs;
+		{
+			std::lock_guard<std::mutex> lock(s_Data.MainThreadMutex);
+			jobs.swap(s_Data.MainThreadJobs);
+		}
+		for (JobFn& job : jobs)
+			job();
+	}
+
+	uint32_t JobSystem::GetWorkerCount()
+	{
+		return (uint32_t)s_Data.Workers.size();
+	}
+
+	bool JobSystem::IsMainThread()
+	{
+		return std::this_thread::get_id() == s_Data.MainThreadID;
+	}
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+
+namespace Hazel {
+
+	// Number of unfinished jobs a counter was handed to, zero once they are all done
+	class JobCounter
+	{
+	public:
+		JobCounter() = default;
+		JobCounter(const JobCounter&) = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+
+		bool IsDone() const { return m_Value.load(std::memory_order_acquire) == 0; }
+		uint32_t GetValue() const { return m_Value.load(std::memory_order_acquire); }
+	private:
+		std::atomic<uint32_t> m_Value = 0;
+
+		friend class JobSystem;
+	};
+
+	// Worker threads, one per core minus the main thread, each owning a deque of jobs.
+	// A worker pops its own newest job first and steals the oldest job of another
+	// thread when it runs dry. Jobs must not touch the graphics context, use
+	// RunOnMainThread for that.
+	class JobSystem
+	{
+	public:
+		using JobFn = std::function<void()>;
+		using RangeFn = std::function<void(uint32_t begin, uint32_t end)>;
+
+		static void Init(uint32_t workerCount = 0); // 0 = one per core, minus the main thread
+		// Runs every pending job, including the ones they queue in turn, before the workers stop
+		static void Shutdown();
+
+		// The counter, if any, is incremented now and decremented once the job finished.
+		// Without Init (or after Shutdown) the job runs right away on the calling thread
+		static void Run(JobFn job, JobCounter* counter = nullptr);
+		// Blocks until the counter reaches zero, running other jobs in the meantime,
+		// so it is fine to wait from inside a job
+		static void Wait(const JobCounter& counter);
+
+		// Splits [0, count) into batches of batchSize, runs them across all cores
+		// (including the calling thread) and returns when all are done
+		static void ParallelFor(uint32_t count, uint32_t batchSize, const RangeFn& func);
+
+		// Queues work for the main thread, run by ProcessMainThreadJobs once per frame
+		static void RunOnMainThread(JobFn job);
+		static void ProcessMainThreadJobs();
+
+		static uint32_t GetWorkerCount();
+		static bool IsMainThread();
+	private:
+		static bool TryRunJob();
+		static void WorkerLoop(uint32_t index);
+	};
+
+}
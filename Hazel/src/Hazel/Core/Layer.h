@@ -14,6 +14,8 @@ namespace Hazel {
 		virtual void OnAttach() {}
 		virtual void OnDetach() {}
 		virtual void OnUpdate(TimeStep ts) {}
+		// only called when the Application runs a fixed time step, always with that step
+		virtual void OnFixedUpdate(TimeStep ts) {}
 		virtual void OnImGuiRender() {}
 		virtual void OnEvent(Event& event) {}
 
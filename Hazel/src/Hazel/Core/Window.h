@@ -6,6 +6,8 @@
 
 namespace Hazel {
 
+	class GraphicsContext;
+
 	struct WindowProps
 	{
 		std::string Title;
@@ -42,6 +44,7 @@ namespace Hazel {
 		virtual bool IsCursorEnabled() const = 0;
 
 		virtual void* GetNativeWindow() const = 0;
+		virtual GraphicsContext& GetContext() const = 0;
 
 		static Window* Create(const WindowProps& props = WindowProps());
 	};
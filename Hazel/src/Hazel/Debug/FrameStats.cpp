@@ -0,0 +1,211 @@
+#include "hzpch.h"
+#include "FrameStats.h"
+
+#include "Hazel/Core/Timer.h"
+#include "Hazel/Renderer/GPUTimer.h"
+#include "Hazel/Renderer/RendererAPI.h"
+
+#include <map>
+
+namespace Hazel {
+
+	// One value per frame, indexed by the frame number modulo HistorySize
+	using History = std::array<float, FrameStats::HistorySize>;
+
+	struct GPUPass
+	{
+		Ref<GPUTimer> Timer;
+		History Times = {};
+	};
+
+	struct FrameStatsData
+	{
+		std::array<FrameStats::Frame, FrameStats::HistorySize> Frames;
+		uint64_t FrameIndex = 0; // frame being recorded
+		bool InFrame = false;
+
+		Timer FrameTimer;
+		Timer CPUTimer;
+
+		std::map<std::string, std::array<History, (size_t)FrameStats::CPUSection::Count>> CPUSections;
+		std::map<std::string, GPUPass> GPUPasses;
+		GPUPass* ActivePass = nullptr;
+	};
+
+	static FrameStatsData s_Data;
+
+	static uint32_t CurrentSlot()
+	{
+		return (uint32_t)(s_Data.FrameIndex % FrameStats::HistorySize);
+	}
+
+	static FrameStats::Percentiles CalculatePercentiles(std::vector<float>& values)
+	{
+		FrameStats::Percentiles result;
+		if (values.empty())
+			return result;
+
+		auto at = [&values](float p)
+		{
+			auto nth = values.begin() + (size_t)(p * (values.size() - 1) + 0.5f);
+			std::nth_element(values.begin(), nth, values.end());
+			return *nth;
+		};
+		result.P50 = at(0.50f);
+		result.P95 = at(0.95f);
+		result.P99 = at(0.99f);
+		return result;
+	}
+
+	static FrameStats::Percentiles CalculatePercentiles(const History& history)
+	{
+		uint32_t count = FrameStats::GetFrameCount();
+		std::vector<float> values;
+		values.reserve(count);
+		for (uint32_t age = 1; age <= count; age++)
+			values.push_back(history[(s_Data.FrameIndex - age) % FrameStats::HistorySize]);
+		return CalculatePercentiles(values);
+	}
+
+	void FrameStats::Shutdown()
+	{
+		// GPU timers have to go while the context is still around
+		s_Data.GPUPasses.clear();
+		s_Data.ActivePass = nullptr;
+	}
+
+	void FrameStats::BeginFrame()
+	{
+		HZ_CORE_ASSERT(!s_Data.InFrame, "FrameStats::BeginFrame called twice!");
+		s_Data.InFrame = true;
+
+		uint32_t slot = CurrentSlot();
+		s_Data.Frames[slot] = Frame();
+		s_Data.Frames[slot].FrameTime = s_Data.FrameIndex > 0 ? s_Data.FrameTimer.ElapsedMillis() : 0.0f;
+		s_Data.FrameTimer.Reset();
+		s_Data.CPUTimer.Reset();
+
+		// sections that do not run this frame count as zero
+		for (auto& [name, sections] : s_Data.CPUSections)
+			for (History& history : sections)
+				history[slot] = 0.0f;
+
+		RendererAPI::ResetCounters();
+	}
+
+	void FrameStats::EndFrame()
+	{
+		HZ_CORE_ASSERT(s_Data.InFrame, "FrameStats::EndFrame called without BeginFrame!");
+		HZ_CORE_ASSERT(!s_Data.ActivePass, "GPU pass still active at the end of the frame!");
+		s_Data.InFrame = false;
+
+		uint32_t slot = CurrentSlot();
+		Frame& frame = s_Data.Frames[slot];
+		frame.CPUTime = s_Data.CPUTimer.ElapsedMillis();
+
+		// passes that did not run this frame keep reporting their last result
+		for (auto& [name, pass] : s_Data.GPUPasses)
+		{
+			pass.Times[slot] = pass.Timer->GetElapsedMillis();
+			frame.GPUTime += pass.Times[slot];
+		}
+
+		const RendererAPI::Counters& counters = RendererAPI::GetCounters();
+		frame.DrawCalls = counters.DrawCalls;
+		frame.Indices = counters.Indices;
+		frame.StateChanges = counters.StateChanges;
+		frame.SkippedStateChanges = counters.SkippedStateChanges;
+		frame.UploadedBytes = counters.UploadedBytes;
+
+		s_Data.FrameIndex++;
+	}
+
+	void FrameStats::AddCPUTime(const std::string& name, CPUSection section, float millis)
+	{
+		auto it = s_Data.CPUSections.find(name);
+		if (it == s_Data.CPUSections.end())
+			it = s_Data.CPUSections.emplace(name, std::array<History, (size_t)CPUSection::Count>()).first;
+
+		it->second[(size_t)section][CurrentSlot()] += millis;
+	}
+
+	void FrameStats::BeginGPUPass(const std::string& name)
+	{
+		HZ_CORE_ASSERT(!s_Data.ActivePass, "GPU passes cannot be nested!");
+
+		GPUPass& pass = s_Data.GPUPasses[name];
+		if (!pass.Timer)
+			pass.Timer = GPUTimer::Create();
+
+		pass.Timer->Begin();
+		s_Data.ActivePass = &pass;
+	}
+
+	void FrameStats::EndGPUPass()
+	{
+		HZ_CORE_ASSERT(s_Data.ActivePass, "No GPU pass to end!");
+		s_Data.ActivePass->Timer->End();
+		s_Data.ActivePass = nullptr;
+	}
+
+	uint32_t FrameStats::GetFrameCount()
+	{
+		return (uint32_t)std::min<uint64_t>(s_Data.FrameIndex, HistorySize);
+	}
+
+	const FrameStats::Frame& FrameStats::GetFrame(uint32_t age)
+	{
+		HZ_CORE_ASSERT(age < GetFrameCount(), "Frame is not in the history!");
+		return s_Data.Frames[(s_Data.FrameIndex - 1 - age) % HistorySize];
+	}
+
+	FrameStats::Percentiles FrameStats::GetPercentiles(float Frame::* metric)
+	{
+		std::vector<float> values;
+		GetHistory(metric, values);
+		return CalculatePercentiles(values);
+	}
+
+	FrameStats::Percentiles FrameStats::GetCPUPercentiles(const std::string& name, CPUSection section)
+	{
+		auto it = s_Data.CPUSections.find(name);
+		if (it == s_Data.CPUSections.end())
+			return Percentiles();
+
+		return CalculatePercentiles(it->second[(size_t)section]);
+	}
+
+	FrameStats::Percentiles FrameStats::GetGPUPassPercentiles(const std::string& name)
+	{
+		auto it = s_Data.GPUPasses.find(name);
+		if (it == s_Data.GPUPasses.end())
+			return Percentiles();
+
+		return CalculatePercentiles(it->second.Times);
+	}
+
+	void FrameStats::GetHistory(float Frame::* metric, std::vector<float>& values)
+	{
+		uint32_t count = GetFrameCount();
+		values.resize(count);
+		for (uint32_t i = 0; i < count; i++)
+			values[i] = GetFrame(count - 1 - i).*metric;
+	}
+
+	std::vector<std::string> FrameStats::GetCPUSectionNames()
+	{
+		std::vector<std::string> names;
+		for (auto& [name, sections] : s_Data.CPUSections)
+			names.push_back(name);
+		return names;
+	}
+
+	std::vector<std::string> FrameStats::GetGPUPassNames()
+	{
+		std::vector<std::string> names;
+		for (auto& [name, pass] : s_Data.GPUPasses)
+			names.push_back(name);
+		return names;
+	}
+
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Hazel {
+
+	// Rolling per-frame timings and GPU workload, fed by Application::Run.
+	// All functions are main thread only.
+	class FrameStats
+	{
+	public:
+		static constexpr uint32_t HistorySize = 4096;
+
+		struct Frame
+		{
+			float FrameTime = 0.0f; // ms between the start of this frame and the previous one
+			float CPUTime = 0.0f;   // ms spent on the main thread, without waiting for the swap
+			float GPUTime = 0.0f;   // ms over all GPU passes, lags a frame or two behind
+			uint32_t DrawCalls = 0;
+			uint32_t Indices = 0;
+			uint32_t StateChanges = 0;
+			uint32_t SkippedStateChanges = 0;
+			uint32_t UploadedBytes = 0;
+		};
+
+		struct Percentiles
+		{
+			float P50 = 0.0f, P95 = 0.0f, P99 = 0.0f;
+		};
+
+		enum class CPUSection
+		{
+			Update = 0, FixedUpdate, ImGuiRender, Count
+		};
+
+		static void Shutdown();
+
+		static void BeginFrame();
+		static void EndFrame();
+
+		// CPU time of one section of a frame, e.g. a layer's OnUpdate
+		static void AddCPUTime(const std::string& name, CPUSection section, float millis);
+
+		// GPU passes cannot be nested
+		static void BeginGPUPass(const std::string& name);
+		static void EndGPUPass();
+
+		// number of completed frames in the history, at most HistorySize
+		static uint32_t GetFrameCount();
+		// age 0 is the last completed frame
+		static const Frame& GetFrame(uint32_t age = 0);
+
+		// e.g. GetPercentiles(&FrameStats::Frame::CPUTime)
+		static Percentiles GetPercentiles(float Frame::* metric);
+		static Percentiles GetCPUPercentiles(const std::string& name, CPUSection section);
+		static Percentiles GetGPUPassPercentiles(const std::string& name);
+
+		// oldest first, one value per completed frame
+		static void GetHistory(float Frame::* metric, std::vector<float>& values);
+
+		static std::vector<std::string> GetCPUSectionNames();
+		static std::vector<std::string> GetGPUPassNames();
+	};
+
+}
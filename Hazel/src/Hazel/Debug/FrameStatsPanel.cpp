@@ -0,0 +1,82 @@
+#include "hzpch.h"
+#include "FrameStatsPanel.h"
+
+#include "FrameStats.h"
+#include "Hazel/Core/Application.h"
+#include "Hazel/Renderer/Renderer.h"
+#include "Hazel/Renderer/RenderThread.h"
+
+#include "imgui.h"
+
+namespace Hazel {
+
+	static void PercentilesRow(const char* label, const FrameStats::Percentiles& percentiles)
+	{
+		ImGui::Text("%-24s %8.3f %8.3f %8.3f", label, percentiles.P50, percentiles.P95, percentiles.P99);
+	}
+
+	void FrameStatsPanel::OnImGuiRender(bool* open)
+	{
+		if (!ImGui::Begin("Frame Stats", open))
+		{
+			ImGui::End();
+			return;
+		}
+
+		if (FrameStats::GetFrameCount() == 0)
+		{
+			ImGui::End();
+			return;
+		}
+
+		const FrameStats::Frame& frame = FrameStats::GetFrame();
+		ImGui::Text("Frame %.3f ms, CPU %.3f ms, GPU %.3f ms", frame.FrameTime, frame.CPUTime, frame.GPUTime);
+		ImGui::Text("Draw calls %u, indices %u, uploaded %.1f KB", frame.DrawCalls, frame.Indices, frame.UploadedBytes / 1024.0f);
+		ImGui::Text("State changes %u, redundant ones skipped %u", frame.StateChanges, frame.SkippedStateChanges);
+		Renderer::Statistics rendererStats = Renderer::GetStats();
+		ImGui::Text("Cubes visible %u, culled %u", rendererStats.VisibleCubes, rendererStats.CulledCubes);
+
+		Application& app = Application::Get();
+		bool renderThread = app.IsRenderThreadEnabled();
+		if (ImGui::Checkbox("Render thread", &renderThread))
+			app.SetRenderThreadEnabled(renderThread);
+		if (RenderThread::IsRunning())
+		{
+			RenderThread::Statistics stats = RenderThread::GetStats();
+			ImGui::Text("%u commands (%.1f KB), replay %.3f ms, waited %.3f ms",
+				stats.Commands, stats.CommandBytes / 1024.0f, stats.ExecuteMillis, stats.WaitMillis);
+		}
+
+		static std::vector<float> s_History;
+		FrameStats::GetHistory(&FrameStats::Frame::FrameTime, s_History);
+		ImGui::PlotLines("##FrameTime", s_History.data(), (int)s_History.size(), 0, "frame time (ms)", 0.0f, FLT_MAX, ImVec2(0.0f, 60.0f));
+
+		ImGui::Separator();
+		ImGui::Text("Over the last %u frames (ms)", FrameStats::GetFrameCount());
+		ImGui::Text("%-24s %8s %8s %8s", "", "p50", "p95", "p99");
+		PercentilesRow("Frame", FrameStats::GetPercentiles(&FrameStats::Frame::FrameTime));
+		PercentilesRow("CPU", FrameStats::GetPercentiles(&FrameStats::Frame::CPUTime));
+		PercentilesRow("GPU", FrameStats::GetPercentiles(&FrameStats::Frame::GPUTime));
+
+		if (ImGui::TreeNodeEx("Layers (CPU)", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			for (const std::string& name : FrameStats::GetCPUSectionNames())
+			{
+				PercentilesRow((name + " update").c_str(), FrameStats::GetCPUPercentiles(name, FrameStats::CPUSection::Update));
+				PercentilesRow((name + " fixed").c_str(), FrameStats::GetCPUPercentiles(name, FrameStats::CPUSection::FixedUpdate));
+				PercentilesRow((name + " imgui").c_str(), FrameStats::GetCPUPercentiles(name, FrameStats::CPUSection::ImGuiRender));
+			}
+			ImGui::TreePop();
+		}
+
+		if (ImGui::TreeNodeEx("Passes (GPU)", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			for (const std::string& name : FrameStats::GetGPUPassNames())
+				PercentilesRow(name.c_str(), FrameStats::GetGPUPassPercentiles(name));
+			ImGui::TreePop();
+		}
+
+		ImGui::End();
+	}
+
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+namespace Hazel {
+
+	// ImGui window showing FrameStats, call from a layer's OnImGuiRender
+	class FrameStatsPanel
+	{
+	public:
+		static void OnImGuiRender(bool* open = nullptr);
+	};
+
+}
@@ -0,0 +1,271 @@
+#include "hzpch.h"
+#include "Instrumentor.h"
+#include "TraceFormat.h"
+
+#include <ctime>
+
+namespace Hazel {
+
+	// Single producer (the owning thread), single consumer (the writer thread)
+	class ProfileEventBuffer
+	{
+	public:
+		static constexpr uint32_t Capacity = 1 << 14; // power of two
+
+		ProfileEventBuffer(uint32_t threadIndex)
+			: ThreadIndex(threadIndex)
+		{
+		}
+
+		bool Push(const ProfileEvent& event)
+		{
+			uint32_t head = m_Head.load(std::memory_order_relaxed);
+			if (head - m_Tail.load(std::memory_order_acquire) == Capacity)
+			{
+				Dropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+
+			m_Events[head & (Capacity - 1)] = event;
+			m_Head.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+		template<typename F>
+		void Drain(const F& func)
+		{
+			uint32_t tail = m_Tail.load(std::memory_order_relaxed);
+			uint32_t head = m_Head.load(std::memory_order_acquire);
+			for (; tail != head; tail++)
+				func(m_Events[tail & (Capacity - 1)]);
+			m_Tail.store(tail, std::memory_order_release);
+		}
+
+		bool IsEmpty() const
+		{
+			return m_Head.load(std::memory_order_acquire) == m_Tail.load(std::memory_order_relaxed);
+		}
+	public:
+		const uint32_t ThreadIndex;
+		std::atomic<uint64_t> Dropped = 0;
+		std::atomic<bool> Orphaned = false; // owning thread has exited
+	private:
+		std::array<ProfileEvent, Capacity> m_Events;
+		alignas(64) std::atomic<uint32_t> m_Head = 0;
+		alignas(64) std::atomic<uint32_t> m_Tail = 0;
+	};
+
+	// Registers the calling thread's buffer on first use and hands it over to the writer on exit
+	struct ProfileThreadBufferHandle
+	{
+		std::shared_ptr<ProfileEventBuffer> Buffer;
+
+		ProfileThreadBufferHandle()
+		{
+			Instrumentor& instrumentor = Instrumentor::Get();
+			std::lock_guard<std::mutex> lock(instrumentor.m_BuffersMutex);
+			Buffer = std::make_shared<ProfileEventBuffer>(instrumentor.m_NextThreadIndex++);
+			instrumentor.m_Buffers.push_back(Buffer);
+		}
+
+		~ProfileThreadBufferHandle()
+		{
+			Buffer->Orphaned.store(true, std::memory_order_release);
+		}
+	};
+
+	Instrumentor::~Instrumentor()
+	{
+		if (IsSessionActive())
+			EndSession();
+	}
+
+	void Instrumentor::BeginSession(const std::string& name, const std::string& filepath)
+	{
+		if (IsSessionActive())
+			EndSession();
+
+		// whatever was recorded while the previous session shut down belongs to nobody
+		Drain(false);
+
+		m_SessionName = name;
+		m_OutputStream.open(filepath, std::ios::out | std::ios::binary);
+		m_WrittenNames.clear();
+		m_LastStart.clear();
+
+		m_WriteBuffer.clear();
+		m_WriteBuffer.insert(m_WriteBuffer.end(), std::begin(TraceFormat::Magic), std::end(TraceFormat::Magic));
+		TraceFormat::WriteVarint(m_WriteBuffer, TraceFormat::Version);
+		TraceFormat::WriteString(m_WriteBuffer, name);
+		m_OutputStream.write((const char*)m_WriteBuffer.data(), m_WriteBuffer.size());
+
+		m_StopWriter = false;
+		m_Writer = std::thread(&Instrumentor::WriterLoop, this);
+		m_SessionActive.store(true, std::memory_order_relaxed);
+	}
+
+	void Instrumentor::EndSession()
+	{
+		if (!IsSessionActive())
+			return;
+
+		m_SessionActive.store(false, std::memory_order_relaxed);
+		{
+			std::lock_guard<std::mutex> lock(m_WriterMutex);
+			m_StopWriter = true;
+		}
+		m_WriterCondition.notify_one();
+		m_Writer.join();
+
+		Drain(true);
+		m_OutputStream.close();
+
+		uint64_t dropped = 0;
+		{
+			std::lock_guard<std::mutex> lock(m_BuffersMutex);
+			for (auto& buffer : m_Buffers)
+				dropped += buffer->Dropped.exchange(0, std::memory_order_relaxed);
+		}
+		if (dropped)
+			HZ_CORE_WARN("Profiling session '{0}' dropped {1} events, the writer could not keep up", m_SessionName, dropped);
+	}
+
+	void Instrumentor::CaptureFrames(uint32_t frameCount, const std::string& filepath)
+	{
+		if (IsSessionActive())
+		{
+			HZ_CORE_WARN("Cannot capture {0} frames, profiling session '{1}' is already running", frameCount, m_SessionName);
+			return;
+		}
+
+		m_PendingCaptureFrames = frameCount;
+		m_PendingCapturePath = filepath;
+		if (m_PendingCapturePath.empty())
+		{
+			std::time_t now = std::time(nullptr);
+			char timestamp[32];
+			std::strftime(timestamp, sizeof(timestamp), "%Y%m%d-%H%M%S", std::localtime(&now));
+			m_PendingCapturePath = std::string("HazelCapture-") + timestamp + ".hztrace";
+		}
+	}
+
+	void Instrumentor::StopCapture()
+	{
+		if (IsCapturing())
+			m_CaptureFrameCount = m_CapturedFrames + 1;
+		m_PendingCaptureFrames = 0;
+	}
+
+	void Instrumentor::NewFrame()
+	{
+		if (m_CaptureFrameCount > 0 && ++m_CapturedFrames >= m_CaptureFrameCount)
+		{
+			EndSession();
+			HZ_CORE_INFO("Captured {0} frames to '{1}'", m_CapturedFrames, m_CapturePath);
+			m_CaptureFrameCount = 0;
+		}
+
+		if (m_PendingCaptureFrames > 0)
+		{
+			if (IsSessionActive())
+			{
+				HZ_CORE_WARN("Cannot capture {0} frames, profiling session '{1}' is already running", m_PendingCaptureFrames, m_SessionName);
+			}
+			else
+			{
+				m_CapturePath = m_PendingCapturePath;
+				m_CaptureFrameCount = m_PendingCaptureFrames;
+				m_CapturedFrames = 0;
+				BeginSession("Capture", m_CapturePath);
+			}
+			m_PendingCaptureFrames = 0;
+		}
+	}
+
+	uint32_t Instrumentor::InternName(const char* name)
+	{
+		std::lock_guard<std::mutex> lock(m_NamesMutex);
+		auto it = m_NameIDs.find(name);
+		if (it != m_NameIDs.end())
+			return it->second;
+
+		uint32_t id = (uint32_t)m_Names.size();
+		m_Names.push_back(name);
+		m_NameIDs[name] = id;
+		return id;
+	}
+
+	void Instrumentor::Record(uint32_t nameID, int64_t start, int64_t end)
+	{
+		GetThreadBuffer().Push({ start, end, nameID });
+	}
+
+	ProfileEventBuffer& Instrumentor::GetThreadBuffer()
+	{
+		static thread_local ProfileThreadBufferHandle handle;
+		return *handle.Buffer;
+	}
+
+	void Instrumentor::WriterLoop()
+	{
+		std::unique_lock<std::mutex> lock(m_WriterMutex);
+		while (!m_StopWriter)
+		{
+			m_WriterCondition.wait_for(lock, std::chrono::milliseconds(10));
+			Drain(true);
+		}
+	}
+
+	void Instrumentor::Drain(bool write)
+	{
+		std::vector<std::shared_ptr<ProfileEventBuffer>> buffers;
+		{
+			std::lock_guard<std::mutex> lock(m_BuffersMutex);
+			buffers = m_Buffers;
+		}
+
+		m_WriteBuffer.clear();
+		{
+			std::lock_guard<std::mutex> lock(m_NamesMutex);
+			for (auto& buffer : buffers)
+			{
+				if (write && buffer->ThreadIndex >= m_LastStart.size())
+					m_LastStart.resize(buffer->ThreadIndex + 1, 0);
+
+				buffer->Drain([this, write, &buffer](const ProfileEvent& event)
+				{
+					if (!write)
+						return;
+
+					if (event.NameID >= m_WrittenNames.size())
+						m_WrittenNames.resize(event.NameID + 1, false);
+					if (!m_WrittenNames[event.NameID])
+					{
+						m_WriteBuffer.push_back((uint8_t)TraceFormat::RecordType::Name);
+						TraceFormat::WriteVarint(m_WriteBuffer, event.NameID);
+						TraceFormat::WriteString(m_WriteBuffer, m_Names[event.NameID]);
+						m_WrittenNames[event.NameID] = true;
+					}
+
+					int64_t& lastStart = m_LastStart[buffer->ThreadIndex];
+					m_WriteBuffer.push_back((uint8_t)TraceFormat::RecordType::Event);
+					TraceFormat::WriteVarint(m_WriteBuffer, buffer->ThreadIndex);
+					TraceFormat::WriteVarint(m_WriteBuffer, event.NameID);
+					TraceFormat::WriteVarint(m_WriteBuffer, TraceFormat::ZigZagEncode(event.Start - lastStart));
+					TraceFormat::WriteVarint(m_WriteBuffer, event.End - event.Start);
+					lastStart = event.Start;
+				});
+			}
+		}
+		if (!m_WriteBuffer.empty())
+			m_OutputStream.write((const char*)m_WriteBuffer.data(), m_WriteBuffer.size());
+
+		// buffers of exited threads go away once nothing is left in them
+		std::lock_guard<std::mutex> lock(m_BuffersMutex);
+		m_Buffers.erase(std::remove_if(m_Buffers.begin(), m_Buffers.end(), [](const std::shared_ptr<ProfileEventBuffer>& buffer)
+		{
+			return buffer->Orphaned.load(std::memory_order_acquire) && buffer->IsEmpty();
+		}), m_Buffers.end());
+	}
+
+}
@@ -1,85 +1,65 @@
 #pragma once
-#pragma once
 
-#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <fstream>
-#include <iomanip>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace Hazel {
-	struct ProfileResult
-	{
-		std::string Name;
-		long long Start, End;
-		size_t ThreadID;
-	};
 
-	struct InstrumentationSession
+	// Fixed size record of a finished scope, timestamps are in nanoseconds
+	struct ProfileEvent
 	{
-		std::string Name;
+		int64_t Start, End;
+		uint32_t NameID;
 	};
 
+	class ProfileEventBuffer;
+
+	// Scopes are pushed into a lock-free ring buffer owned by the recording thread
+	// and drained into a binary trace (see TraceFormat.h) by a background writer thread.
+	// When a buffer is full the event is dropped rather than stalling the thread.
+	// HazelTrace converts the trace to Chrome tracing JSON or per-scope statistics.
+	//
+	// Scopes are always compiled in, outside a session they cost one relaxed atomic load.
+	// Sessions are started explicitly or by CaptureFrames.
 	class Instrumentor
 	{
-	private:
-		InstrumentationSession* m_CurrentSession;
-		std::ofstream m_OutputStream;
-		int m_ProfileCount;
 	public:
-		Instrumentor()
-			: m_CurrentSession(nullptr), m_ProfileCount(0)
-		{
-		}
+		void BeginSession(const std::string& name, const std::string& filepath = "results.hztrace");
+		void EndSession();
 
-		void BeginSession(const std::string& name, const std::string& filepath = "results.json")
-		{
-			m_OutputStream.open(filepath);
-			WriteHeader();
-			m_CurrentSession = new InstrumentationSession{ name };
-		}
+		bool IsSessionActive() const { return m_SessionActive.load(std::memory_order_relaxed); }
 
-		void EndSession()
-		{
-			WriteFooter();
-			m_OutputStream.close();
-			delete m_CurrentSession;
-			m_CurrentSession = nullptr;
-			m_ProfileCount = 0;
-		}
+		// Records the next frameCount frames into a session of their own, starting at the
+		// next frame boundary. An empty path picks a timestamped file name. Ignored (with a
+		// warning) while another session is running. Main thread only, like NewFrame.
+		void CaptureFrames(uint32_t frameCount, const std::string& filepath = "");
+		// ends a running capture at the next frame boundary
+		void StopCapture();
+		// frame boundary, called by Application::Run through HZ_PROFILE_NEW_FRAME
+		void NewFrame();
 
-		void WriteProfile(const ProfileResult& result)
-		{
-			if (m_ProfileCount++ > 0)
-				m_OutputStream << ",";
-
-			std::string name = result.Name;
-			std::replace(name.begin(), name.end(), '"', '\'');
-
-			m_OutputStream << "{";
-			m_OutputStream << "\"cat\":\"function\",";
-			m_OutputStream << "\"dur\":" << (result.End - result.Start) << ',';
-			m_OutputStream << "\"name\":\"" << name << "\",";
-			m_OutputStream << "\"ph\":\"X\",";
-			m_OutputStream << "\"pid\":0,";
-			m_OutputStream << "\"tid\":" << result.ThreadID << ",";
-			m_OutputStream << "\"ts\":" << result.Start;
-			m_OutputStream << "}";
-
-			m_OutputStream.flush();
-		}
+		bool IsCapturing() const { return m_CaptureFrameCount > 0; }
+		uint32_t GetCapturedFrameCount() const { return m_CapturedFrames; }
+		uint32_t GetCaptureFrameCount() const { return m_CaptureFrameCount; }
+		const std::string& GetCapturePath() const { return m_CapturePath; }
 
-		void WriteHeader()
-		{
-			m_OutputStream << "{\"otherData\": {},\"traceEvents\":[";
-			m_OutputStream.flush();
-		}
+		// Returns a stable ID for the name, the string is copied once and never again
+		uint32_t InternName(const char* name);
+
+		void Record(uint32_t nameID, int64_t start, int64_t end);
 
-		void WriteFooter()
+		static int64_t Now()
 		{
-			m_OutputStream << "]}";
-			m_OutputStream.flush();
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
 		}
 
 		static Instrumentor& Get()
@@ -87,15 +67,51 @@ namespace Hazel {
 			static Instrumentor instance;
 			return instance;
 		}
+	private:
+		Instrumentor() = default;
+		~Instrumentor();
+
+		ProfileEventBuffer& GetThreadBuffer();
+
+		void WriterLoop();
+		void Drain(bool write);
+	private:
+		std::atomic<bool> m_SessionActive = false;
+		std::string m_SessionName;
+		std::ofstream m_OutputStream;
+		std::vector<uint8_t> m_WriteBuffer;
+		std::vector<bool> m_WrittenNames;
+		std::vector<int64_t> m_LastStart; // per thread index, for delta encoding
+
+		std::mutex m_NamesMutex;
+		std::deque<std::string> m_Names;
+		std::unordered_map<std::string, uint32_t> m_NameIDs;
+
+		std::mutex m_BuffersMutex;
+		std::vector<std::shared_ptr<ProfileEventBuffer>> m_Buffers;
+		uint32_t m_NextThreadIndex = 0;
+
+		uint32_t m_PendingCaptureFrames = 0;
+		std::string m_PendingCapturePath;
+		uint32_t m_CaptureFrameCount = 0;
+		uint32_t m_CapturedFrames = 0;
+		std::string m_CapturePath; // current or last capture
+
+		std::thread m_Writer;
+		std::mutex m_WriterMutex;
+		std::condition_variable m_WriterCondition;
+		bool m_StopWriter = false;
+
+		friend struct ProfileThreadBufferHandle;
 	};
 
 	class InstrumentationTimer
 	{
 	public:
-		InstrumentationTimer(const char* name)
-			: m_Name(name), m_Stopped(false)
+		InstrumentationTimer(uint32_t nameID)
+			: m_NameID(nameID), m_Stopped(false)
 		{
-			m_StartTimepoint = std::chrono::high_resolution_clock::now();
+			m_Start = Instrumentor::Get().IsSessionActive() ? Instrumentor::Now() : -1;
 		}
 
 		~InstrumentationTimer()
@@ -106,34 +122,60 @@ namespace Hazel {
 
 		void Stop()
 		{
-			auto endTimepoint = std::chrono::high_resolution_clock::now();
-
-			long long start = std::chrono::time_point_cast<std::chrono::microseconds>(m_StartTimepoint).time_since_epoch().count();
-			long long end = std::chrono::time_point_cast<std::chrono::microseconds>(endTimepoint).time_since_epoch().count();
-
-			size_t threadID = std::hash<std::thread::id>{}(std::this_thread::get_id());
-			Instrumentor::Get().WriteProfile({ m_Name, start, end, threadID });
+			if (m_Start >= 0)
+				Instrumentor::Get().Record(m_NameID, m_Start, Instrumentor::Now());
 
 			m_Stopped = true;
 		}
 	private:
-		const char* m_Name;
-		std::chrono::time_point<std::chrono::high_resolution_clock> m_StartTimepoint;
+		uint32_t m_NameID;
+		int64_t m_Start;
 		bool m_Stopped;
 	};
 }
 
+// Define HZ_PROFILE=0 to compile the scopes out entirely
+#ifndef HZ_PROFILE
+	#define HZ_PROFILE 1
+#endif
+
+#define HZ_PROFILE_CONCAT_IMPL(a, b) a##b
+#define HZ_PROFILE_CONCAT(a, b) HZ_PROFILE_CONCAT_IMPL(a, b)
 
-#define HZ_PROFILE 0
+#if defined(_MSC_VER)
+	#define HZ_FUNC_SIG __FUNCSIG__
+#elif defined(__GNUC__) || defined(__clang__)
+	#define HZ_FUNC_SIG __PRETTY_FUNCTION__
+#else
+	#define HZ_FUNC_SIG __func__
+#endif
 
 #if HZ_PROFILE
 	#define HZ_PROFILE_BEGIN_SESSION(name, filepath) ::Hazel::Instrumentor::Get().BeginSession(name, filepath)
 	#define HZ_PROFILE_END_SESSION() ::Hazel::Instrumentor::Get().EndSession()
-	#define HZ_PROFILE_SCOPE(name) ::Hazel::InstrumentationTimer timer##__line__(name)
-	#define HZ_PROFILE_FUNCTION() HZ_PROFILE_SCOPE(__FUNCSIG__)
+	#define HZ_PROFILE_NEW_FRAME() ::Hazel::Instrumentor::Get().NewFrame()
+	// The name is interned once per call site, so it has to be the same string every time,
+	// debug builds assert on that. Names built at runtime go through HZ_PROFILE_SCOPE_DYNAMIC.
+	#ifdef HZ_DEBUG
+		#define HZ_PROFILE_CHECK_NAME_LINE(name, line) static const char* const HZ_PROFILE_CONCAT(hz_profile_literal, line) = (name); \
+			const char* const HZ_PROFILE_CONCAT(hz_profile_current, line) = (name); \
+			HZ_CORE_ASSERT(HZ_PROFILE_CONCAT(hz_profile_literal, line) == HZ_PROFILE_CONCAT(hz_profile_current, line), "HZ_PROFILE_SCOPE needs a constant name, use HZ_PROFILE_SCOPE_DYNAMIC!")
+	#else
+		#define HZ_PROFILE_CHECK_NAME_LINE(name, line)
+	#endif
+	#define HZ_PROFILE_SCOPE_LINE(name, line) HZ_PROFILE_CHECK_NAME_LINE(name, line); \
+		static const uint32_t HZ_PROFILE_CONCAT(hz_profile_name, line) = ::Hazel::Instrumentor::Get().InternName(name); \
+		::Hazel::InstrumentationTimer HZ_PROFILE_CONCAT(hz_profile_timer, line)(HZ_PROFILE_CONCAT(hz_profile_name, line))
+	#define HZ_PROFILE_SCOPE(name) HZ_PROFILE_SCOPE_LINE(name, __LINE__)
+	// interned on every call while a session runs, for names that change between calls
+	#define HZ_PROFILE_SCOPE_DYNAMIC(name) ::Hazel::InstrumentationTimer HZ_PROFILE_CONCAT(hz_profile_timer, __LINE__)( \
+		::Hazel::Instrumentor::Get().IsSessionActive() ? ::Hazel::Instrumentor::Get().InternName(name) : 0)
+	#define HZ_PROFILE_FUNCTION() HZ_PROFILE_SCOPE(HZ_FUNC_SIG)
 #else
 	#define	HZ_PROFILE_BEGIN_SESSION(name, filepath)
 	#define	HZ_PROFILE_END_SESSION()
+	#define	HZ_PROFILE_NEW_FRAME()
 	#define	HZ_PROFILE_SCOPE(name)
+	#define	HZ_PROFILE_SCOPE_DYNAMIC(name)
 	#define	HZ_PROFILE_FUNCTION()
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,48 @@
+#include "hzpch.h"
+#include "ProfilerPanel.h"
+
+#include "imgui.h"
+
+namespace Hazel {
+
+	static int s_CaptureFrameCount = 300;
+
+	void ProfilerPanel::OnImGuiRender(bool* open)
+	{
+		if (!ImGui::Begin("Profiler", open))
+		{
+			ImGui::End();
+			return;
+		}
+
+#if HZ_PROFILE
+		Instrumentor& instrumentor = Instrumentor::Get();
+		if (instrumentor.IsCapturing())
+		{
+			ImGui::Text("Capturing frame %u / %u", instrumentor.GetCapturedFrameCount() + 1, instrumentor.GetCaptureFrameCount());
+			ImGui::ProgressBar((float)instrumentor.GetCapturedFrameCount() / instrumentor.GetCaptureFrameCount());
+			if (ImGui::Button("Stop"))
+				instrumentor.StopCapture();
+		}
+		else if (instrumentor.IsSessionActive())
+		{
+			ImGui::Text("A profiling session is already recording");
+		}
+		else
+		{
+			ImGui::InputInt("Frames", &s_CaptureFrameCount);
+			s_CaptureFrameCount = std::max(s_CaptureFrameCount, 1);
+			if (ImGui::Button("Capture"))
+				instrumentor.CaptureFrames((uint32_t)s_CaptureFrameCount);
+		}
+
+		if (!instrumentor.GetCapturePath().empty())
+			ImGui::Text("Last capture: %s", instrumentor.GetCapturePath().c_str());
+#else
+		ImGui::Text("Profiling was compiled out (HZ_PROFILE=0)");
+#endif
+
+		ImGui::End();
+	}
+
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+namespace Hazel {
+
+	// ImGui window to capture a number of frames with the Instrumentor,
+	// call from a layer's OnImGuiRender
+	class ProfilerPanel
+	{
+	public:
+		static void OnImGuiRender(bool* open = nullptr);
+	};
+
+}
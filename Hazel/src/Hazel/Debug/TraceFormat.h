@@ -0,0 +1,79 @@
+#pragma once
+
+// Binary profiling trace written by the Instrumentor and read by the HazelTrace tool.
+// Only depends on the standard library so tools can include it without the engine.
+//
+// File layout, all integers are LEB128 varints unless noted:
+//   Magic (8 raw bytes), Version, session name length, session name bytes
+//   followed by records until the end of the file, each starting with a RecordType byte:
+//     Name:  name ID, length, bytes          (emitted before the first event using it)
+//     Event: thread index, name ID, zigzag(start - previous start on that thread), duration
+// Timestamps and durations are nanoseconds. Events are in the order scopes ended,
+// so starts are not monotonic within a thread, hence the signed delta.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Hazel { namespace TraceFormat {
+
+	constexpr char Magic[8] = { 'H', 'Z', 'T', 'R', 'A', 'C', 'E', '\0' };
+	constexpr uint32_t Version = 1;
+
+	enum class RecordType : uint8_t
+	{
+		Name = 1,
+		Event = 2
+	};
+
+	inline void WriteVarint(std::vector<uint8_t>& out, uint64_t value)
+	{
+		while (value >= 0x80)
+		{
+			out.push_back((uint8_t)(value | 0x80));
+			value >>= 7;
+		}
+		out.push_back((uint8_t)value);
+	}
+
+	inline bool ReadVarint(const uint8_t*& it, const uint8_t* end, uint64_t& value)
+	{
+		value = 0;
+		for (uint32_t shift = 0; it != end && shift < 64; shift += 7)
+		{
+			uint8_t byte = *it++;
+			value |= (uint64_t)(byte & 0x7f) << shift;
+			if (!(byte & 0x80))
+				return true;
+		}
+		return false;
+	}
+
+	inline uint64_t ZigZagEncode(int64_t value)
+	{
+		return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+	}
+
+	inline int64_t ZigZagDecode(uint64_t value)
+	{
+		return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+	}
+
+	inline void WriteString(std::vector<uint8_t>& out, const std::string& value)
+	{
+		WriteVarint(out, value.size());
+		out.insert(out.end(), value.begin(), value.end());
+	}
+
+	inline bool ReadString(const uint8_t*& it, const uint8_t* end, std::string& value)
+	{
+		uint64_t length;
+		if (!ReadVarint(it, end, length) || length > (uint64_t)(end - it))
+			return false;
+
+		value.assign((const char*)it, (size_t)length);
+		it += length;
+		return true;
+	}
+
+} }
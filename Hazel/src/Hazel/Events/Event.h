@@ -5,10 +5,9 @@
 
 namespace Hazel {
 
-	// Events in Hazel are currently blocking, meaning when an event occurs it
-	// immediately gets a dispached and must be dealt with right then and there.
-	// For the future, a better strategy mighe be to buffer events in an event
-	// bus and process them during the "event" part of the update stage.
+	// Events coming from the window are buffered in the Application's EventQueue
+	// and dispatched once per frame, at the start of the frame before the layers
+	// update. Dispaching an event by hand through OnEvent is still blocking.
 
 	enum class EventType
 	{
@@ -18,6 +17,7 @@ namespace Hazel {
 		KeyPressed, KeyReleased, KeyTyped,
 		MouseButtonPressed, MouseButtonReleased, MouseMoved, MouseScrolled
 	};
+	constexpr size_t EventTypeCount = (size_t)EventType::MouseScrolled + 1; // keep in sync with the last type
 
 	enum EventCategory
 	{
@@ -29,7 +29,7 @@ namespace Hazel {
 		EventCategoryMouseButton = BIT(4)
 	};
 
-#define EVENT_CLASS_TYPE(type) static EventType GetStaticType() { return EventType::##type; }\
+#define EVENT_CLASS_TYPE(type) static EventType GetStaticType() { return EventType::type; }\
 							   virtual EventType GetEventType() const override { return GetStaticType(); }\
 							   virtual const char* GetName() const override { return #type; }
 
@@ -45,34 +45,68 @@ namespace Hazel {
 		virtual int GetCategoryFlags() const = 0;
 		virtual std::string ToString() const { return GetName(); }
 
-		inline bool IsInCategory(EventCategory category)
+		inline bool IsInCategory(EventCategory category) const
 		{
 			return GetCategoryFlags() & category;
 		}
 	};
 
+	// Ad-hoc dispatch to any callable taking the concrete event, e.g. a lambda or
+	// HZ_BIND_EVENT_FN. The callable is invoked directly, nothing is type-erased.
 	class EventDispacher
 	{
-		template<typename T>
-		using EventFn = std::function<bool(T&)>;
 	public:
 		EventDispacher(Event& event)
-			: m_Event(event)
+			: m_Event(event), m_Type(event.GetEventType())
 		{
 		}
 
-		template<typename T>
-		bool Dispach(EventFn<T> func)
+		template<typename T, typename F>
+		bool Dispach(const F& func)
 		{
-			if (m_Event.GetEventType() == T::GetStaticType())
+			if (m_Type == T::GetStaticType())
 			{
-				m_Event.Handled = func(*(T*)&m_Event);
+				m_Event.Handled = func(static_cast<T&>(m_Event));
 				return true;
 			}
 			return false;
 		}
 	private:
 		Event& m_Event;
+		EventType m_Type;
+	};
+
+	// Member function handlers of one class indexed by EventType, so dispatching is a
+	// single table lookup instead of a comparison per handler. Build it once:
+	//   static const EventHandlerTable<Foo> s_Handlers = EventHandlerTable<Foo>()
+	//       .On<WindowResizeEvent, &Foo::OnWindowResize>();
+	//   s_Handlers.Dispach(this, e);
+	template<typename Owner>
+	class EventHandlerTable
+	{
+	public:
+		template<typename T, bool(Owner::*Handler)(T&)>
+		EventHandlerTable& On()
+		{
+			m_Handlers[(size_t)T::GetStaticType()] = [](Owner* owner, Event& event)
+			{
+				return (owner->*Handler)(static_cast<T&>(event));
+			};
+			return *this;
+		}
+
+		bool Dispach(Owner* owner, Event& event) const
+		{
+			HandlerFn handler = m_Handlers[(size_t)event.GetEventType()];
+			if (!handler)
+				return false;
+
+			event.Handled = handler(owner, event);
+			return true;
+		}
+	private:
+		using HandlerFn = bool(*)(Owner*, Event&);
+		std::array<HandlerFn, EventTypeCount> m_Handlers = {};
 	};
 
 	inline std::ostream& operator<<(std::ostream& os, const Event& e)
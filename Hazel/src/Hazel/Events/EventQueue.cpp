@@ -0,0 +1,67 @@
+#include "hzpch.h"
+#include "EventQueue.h"
+
+#include "ApplicationEvent.h"
+#include "KeyEvent.h"
+#include "MouseEvent.h"
+
+namespace Hazel {
+
+	void EventQueue::Push(const Event& event)
+	{
+		switch (event.GetEventType())
+		{
+		case EventType::WindowClose:         Push(static_cast<const WindowCloseEvent&>(event)); return;
+		case EventType::WindowResize:        Push(static_cast<const WindowResizeEvent&>(event)); return;
+		case EventType::AppTick:             Push(static_cast<const AppTickEvent&>(event)); return;
+		case EventType::AppUpdate:           Push(static_cast<const AppUpdateEvent&>(event)); return;
+		case EventType::AppRender:           Push(static_cast<const AppRenderEvent&>(event)); return;
+		case EventType::KeyPressed:          Push(static_cast<const KeyPressedEvent&>(event)); return;
+		case EventType::KeyReleased:         Push(static_cast<const KeyReleasedEvent&>(event)); return;
+		case EventType::KeyTyped:            Push(static_cast<const KeyTypedEvent&>(event)); return;
+		case EventType::MouseButtonPressed:  Push(static_cast<const MouseButtonPressedEvent&>(event)); return;
+		case EventType::MouseButtonReleased: Push(static_cast<const MouseButtonReleasedEvent&>(event)); return;
+		case EventType::MouseMoved:          Push(static_cast<const MouseMovedEvent&>(event)); return;
+		case EventType::MouseScrolled:       Push(static_cast<const MouseScrolledEvent&>(event)); return;
+		// no event class carries these, nothing can be copied into the queue
+		case EventType::None:
+		case EventType::WindowFocus:
+		case EventType::WindowLostFocus:
+		case EventType::WindowMoved:
+			break;
+		}
+
+		// dropped in release builds, the event is not dispatched
+		HZ_CORE_ERROR("Event type {0} is not queueable, the event is dropped", (int)event.GetEventType());
+		HZ_CORE_ASSERT(false, "Event type cannot be queued!");
+	}
+
+	void EventQueue::Clear()
+	{
+		m_Events.clear();
+		m_Coalescable.fill(nullptr);
+		m_CoalescedCount = 0;
+		m_BlockIndex = 0;
+		m_Offset = 0;
+	}
+
+	void* EventQueue::Allocate(size_t size, size_t alignment)
+	{
+		HZ_CORE_ASSERT(size <= BlockSize, "Event is larger than an arena block!");
+
+		m_Offset = (m_Offset + alignment - 1) & ~(alignment - 1);
+		if (m_BlockIndex < m_Blocks.size() && m_Offset + size > BlockSize)
+		{
+			m_BlockIndex++;
+			m_Offset = 0;
+		}
+		// blocks are kept across frames, a new one is only needed the first time a frame gets this busy
+		if (m_BlockIndex == m_Blocks.size())
+			m_Blocks.push_back(Scope<uint8_t[]>(new uint8_t[BlockSize]));
+
+		void* memory = m_Blocks[m_BlockIndex].get() + m_Offset;
+		m_Offset += size;
+		return memory;
+	}
+
+}
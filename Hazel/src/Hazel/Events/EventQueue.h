@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Event.h"
+
+namespace Hazel {
+
+	// Per-frame event bus. Events are copied into a block arena that is reused
+	// every frame and dispatched in arrival order when the Application asks for it.
+	// A MouseMovedEvent replaces the previous one unless another event was queued in
+	// between, and only the latest WindowResizeEvent of a frame is kept.
+	class EventQueue
+	{
+	public:
+		EventQueue() = default;
+		EventQueue(const EventQueue&) = delete;
+		EventQueue& operator=(const EventQueue&) = delete;
+
+		// copies the event based on its runtime type
+		void Push(const Event& event);
+
+		template<typename T>
+		void Push(const T& event)
+		{
+			// arena memory is recycled without running destructors
+			static_assert(std::is_trivially_destructible_v<T>, "Queued events must be trivially destructible!");
+
+			EventType type = T::GetStaticType();
+			if (type == EventType::MouseMoved || type == EventType::WindowResize)
+			{
+				if (Event* previous = m_Coalescable[(size_t)type])
+				{
+					new (previous) T(event);
+					m_CoalescedCount++;
+					return;
+				}
+			}
+
+			// any event queued in between keeps the moves around it apart, so they are not
+			// reordered with it
+			m_Coalescable[(size_t)EventType::MouseMoved] = nullptr;
+
+			T* queued = new (Allocate(sizeof(T), alignof(T))) T(event);
+			m_Events.push_back(queued);
+			if (type == EventType::MouseMoved || type == EventType::WindowResize)
+				m_Coalescable[(size_t)type] = queued;
+		}
+
+		// Hands every queued event to func and empties the queue. Events pushed from
+		// inside func are dispatched in the same call.
+		template<typename F>
+		void Dispatch(const F& func)
+		{
+			HZ_PROFILE_FUNCTION();
+			for (size_t i = 0; i < m_Events.size(); i++)
+			{
+				// never merge into an event that may already have been handled
+				m_Coalescable.fill(nullptr);
+				func(*m_Events[i]);
+			}
+			Clear();
+		}
+
+		void Clear();
+
+		uint32_t GetCount() const { return (uint32_t)m_Events.size(); }
+		// events merged into earlier ones since the last Clear
+		uint32_t GetCoalescedCount() const { return m_CoalescedCount; }
+	private:
+		void* Allocate(size_t size, size_t alignment);
+	private:
+		static constexpr size_t BlockSize = 16 * 1024;
+
+		std::vector<Scope<uint8_t[]>> m_Blocks;
+		size_t m_BlockIndex = 0;
+		size_t m_Offset = 0;
+
+		std::vector<Event*> m_Events;
+		std::array<Event*, EventTypeCount> m_Coalescable = {};
+		uint32_t m_CoalescedCount = 0;
+	};
+
+}
@@ -6,6 +6,8 @@
 #include "examples/imgui_impl_opengl3.h"
 
 #include "Hazel/Core/Application.h"
+#include "Hazel/Renderer/RenderThread.h"
+#include "Hazel/Renderer/RendererAPI.h"
 
 // temportary
 #include <GLFW/glfw3.h>
@@ -13,6 +15,38 @@
 
 namespace Hazel {
 
+	static void SubmitDrawData(const ImDrawData& drawData)
+	{
+		HZ_PROFILE_FUNCTION();
+		// ImGui reuses its draw lists next frame, the render thread gets a copy of its own
+		struct DrawDataCopy
+		{
+			ImDrawData Data;
+			std::vector<ImDrawList*> Lists;
+
+			~DrawDataCopy()
+			{
+				for (ImDrawList* list : Lists)
+					IM_DELETE(list);
+			}
+		};
+
+		auto copy = CreateRef<DrawDataCopy>();
+		copy->Data = drawData;
+		copy->Lists.reserve(drawData.CmdListsCount);
+		for (int i = 0; i < drawData.CmdListsCount; i++)
+			copy->Lists.push_back(drawData.CmdLists[i]->CloneOutput());
+		copy->Data.CmdLists = copy->Lists.data();
+
+		RenderThread::Submit([copy]() { ImGui_ImplOpenGL3_RenderDrawData(&copy->Data); });
+	}
+
+	// without a window and GL context ImGui still builds its frames, they are just not drawn
+	static bool IsHeadless()
+	{
+		return RendererAPI::GetAPI() == RendererAPI::API::Null;
+	}
+
 	ImGuiLayer::ImGuiLayer()
 		: Layer("ImGuiLayer")
 	{
@@ -46,26 +80,54 @@ namespace Hazel {
 			style.Colors[ImGuiCol_WindowBg].w = 1.0f;
 		}
 
+		if (IsHeadless())
+		{
+			io.ConfigFlags &= ~ImGuiConfigFlags_ViewportsEnable;
+			unsigned char* pixels;
+			int width, height;
+			io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+			return;
+		}
+
 		Application& app = Application::Get();
 		GLFWwindow* window = static_cast<GLFWwindow*>(app.GetWindow().GetNativeWindow());
 
 		ImGui_ImplGlfw_InitForOpenGL(window, true);
 		ImGui_ImplOpenGL3_Init("#version 410");
+		// creates the font texture now, the first frame may be recorded for the render thread
+		ImGui_ImplOpenGL3_CreateDeviceObjects();
 	}
 
 	void ImGuiLayer::OnDetach()
 	{
 		HZ_PROFILE_FUNCTION();
-		ImGui_ImplOpenGL3_Shutdown();
-		ImGui_ImplGlfw_Shutdown();
+		if (!IsHeadless())
+		{
+			ImGui_ImplOpenGL3_Shutdown();
+			ImGui_ImplGlfw_Shutdown();
+		}
 		ImGui::DestroyContext();
 	}
 
 	void ImGuiLayer::Begin()
 	{
 		HZ_PROFILE_FUNCTION();
-		ImGui_ImplOpenGL3_NewFrame();
-		ImGui_ImplGlfw_NewFrame();
+		// other viewports are rendered to their own windows right away, which the render thread cannot do
+		if (RenderThread::IsRunning())
+			ImGui::GetIO().ConfigFlags &= ~ImGuiConfigFlags_ViewportsEnable;
+
+		if (IsHeadless())
+		{
+			ImGuiIO& io = ImGui::GetIO();
+			Window& window = Application::Get().GetWindow();
+			io.DisplaySize = ImVec2((float)window.GetWidth(), (float)window.GetHeight());
+			io.DeltaTime = 1.0f / 60.0f;
+		}
+		else
+		{
+			RenderThread::Submit([]() { ImGui_ImplOpenGL3_NewFrame(); });
+			ImGui_ImplGlfw_NewFrame();
+		}
 		ImGui::NewFrame();
 	}
 
@@ -78,7 +140,12 @@ namespace Hazel {
 
 		// Rendering
 		ImGui::Render();
-		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+		if (IsHeadless())
+			return;
+		if (RenderThread::IsRenderThread())
+			ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+		else
+			SubmitDrawData(*ImGui::GetDrawData());
 
 		if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
 		{
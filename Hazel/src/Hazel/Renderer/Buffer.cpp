@@ -3,9 +3,27 @@
 
 #include "Renderer.h"
 #include "Platform/OpenGL/OpenGLBuffer.h"
+#include "Platform/Null/NullBuffer.h"
 
 namespace Hazel {
 
+    Ref<VertexBuffer> VertexBuffer::Create(uint32_t size)
+    {
+        switch (Renderer::GetAPI())
+        {
+        case RendererAPI::API::None:
+            HZ_CORE_ASSERT(false, "RendererAPI::None is not supported!");
+            return nullptr;
+        case RendererAPI::API::OpenGL:
+            return std::make_shared<OpenGLVertexBuffer>(size);
+        case RendererAPI::API::Null:
+            return std::make_shared<NullVertexBuffer>(size);
+        }
+
+        HZ_CORE_ASSERT(false, "Unknown renderer API!");
+        return nullptr;
+    }
+
     Ref<VertexBuffer> VertexBuffer::Create(float* vertecies, uint32_t size)
     {
         switch (Renderer::GetAPI())
@@ -15,6 +33,8 @@ namespace Hazel {
             return nullptr;
         case RendererAPI::API::OpenGL:
             return std::make_shared<OpenGLVertexBuffer>(vertecies, size);
+        case RendererAPI::API::Null:
+            return std::make_shared<NullVertexBuffer>(vertecies, size);
         }
 
         HZ_CORE_ASSERT(false, "Unknown renderer API!");
@@ -30,6 +50,42 @@ namespace Hazel {
             return nullptr;
         case RendererAPI::API::OpenGL:
             return std::make_shared<OpenGLIndexBuffer>(indices, size);
+        case RendererAPI::API::Null:
+            return std::make_shared<NullIndexBuffer>(indices, size);
+        }
+
+        HZ_CORE_ASSERT(false, "Unknown renderer API!");
+        return nullptr;
+    }
+
+    Ref<StreamVertexBuffer> StreamVertexBuffer::Create(uint32_t size)
+    {
+        switch (Renderer::GetAPI())
+        {
+        case RendererAPI::API::None:
+            HZ_CORE_ASSERT(false, "RendererAPI::None is not supported!");
+            return nullptr;
+        case RendererAPI::API::OpenGL:
+            return std::make_shared<OpenGLStreamVertexBuffer>(size);
+        case RendererAPI::API::Null:
+            return std::make_shared<NullStreamVertexBuffer>(size);
+        }
+
+        HZ_CORE_ASSERT(false, "Unknown renderer API!");
+        return nullptr;
+    }
+
+    Ref<StreamIndexBuffer> StreamIndexBuffer::Create(uint32_t count)
+    {
+        switch (Renderer::GetAPI())
+        {
+        case RendererAPI::API::None:
+            HZ_CORE_ASSERT(false, "RendererAPI::None is not supported!");
+            return nullptr;
+        case RendererAPI::API::OpenGL:
+            return std::make_shared<OpenGLStreamIndexBuffer>(count);
+        case RendererAPI::API::Null:
+            return std::make_shared<NullStreamIndexBuffer>(count);
         }
 
         HZ_CORE_ASSERT(false, "Unknown renderer API!");
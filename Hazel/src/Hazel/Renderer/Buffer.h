@@ -41,12 +41,13 @@ namespace Hazel {
 		uint32_t Offset;
 		uint32_t Size;
 		bool Normalized;
+		bool PerInstance; // advances once per instance instead of once per vertex
 
 		BufferElement()
-			:DebugName(""), Type(ShaderDataType::None), Size(0), Offset(0), Normalized(false) {}
+			:DebugName(""), Type(ShaderDataType::None), Size(0), Offset(0), Normalized(false), PerInstance(false) {}
 
-		BufferElement(ShaderDataType type, const std::string& name, bool normalized = false)
-			:DebugName(name), Type(type), Size(ShaderDataTypeSize(type)), Offset(0), Normalized(false)
+		BufferElement(ShaderDataType type, const std::string& name, bool normalized = false, bool perInstance = false)
+			:DebugName(name), Type(type), Size(ShaderDataTypeSize(type)), Offset(0), Normalized(normalized), PerInstance(perInstance)
 		{
 
 		}
@@ -74,6 +75,17 @@ namespace Hazel {
 			HZ_CORE_ASSERT(false, "Unknown ShaderDataType!");
 			return 0;
 		}
+
+		// attribute locations taken in the shader, a matrix takes one per column
+		uint32_t GetLocationCount() const
+		{
+			switch (Type)
+			{
+				case ShaderDataType::Mat3:    return 3;
+				case ShaderDataType::Mat4:    return 4;
+				default:                      return 1;
+			}
+		}
 	};
 
 	class BufferLayout
@@ -88,6 +100,13 @@ namespace Hazel {
 		}
 
 		inline uint32_t GetStride() const { return m_Stride; }
+		inline uint32_t GetLocationCount() const
+		{
+			uint32_t count = 0;
+			for (const auto& element : m_Elements)
+				count += element.GetLocationCount();
+			return count;
+		}
 		inline const std::vector<BufferElement>& GetElements() const { return m_Elements; }
 
 		std::vector<BufferElement>::iterator begin() { return m_Elements.begin(); }
@@ -119,9 +138,12 @@ namespace Hazel {
 		virtual void Bind() const = 0;
 		virtual void Unbind() const = 0;
 
+		virtual void SetData(const void* data, uint32_t size) = 0;
+
 		virtual const BufferLayout& GetLayout() const = 0;
 		virtual void SetLayout(const BufferLayout&) = 0;
 
+		static Ref<VertexBuffer> Create(uint32_t size); // dynamic buffer, filled later with SetData
 		static Ref<VertexBuffer> Create(float* vertecies, uint32_t size);
 	};
 
@@ -138,4 +160,47 @@ namespace Hazel {
 		static Ref<IndexBuffer> Create(uint32_t* indices, uint32_t count);
 	};
 
+	// Memory handed out by Map, the GPU reads it from Offset bytes into the buffer
+	struct BufferSpan
+	{
+		void* Data = nullptr;
+		uint32_t Size = 0;
+		uint32_t Offset = 0;
+
+		template<typename T>
+		T* As() const { return static_cast<T*>(Data); }
+	};
+
+	// Vertex data rewritten every frame, written straight into memory the GPU reads from.
+	// The buffer is a ring of three regions of the size it was created with; a region is only
+	// written again once the GPU finished drawing from it, Map waits for that if needed.
+	// A Map that does not fit in what is left of the current region moves on to the next one,
+	// so a frame mapping more than about two regions' worth waits on the GPU every frame, and
+	// with the render thread running that wait stalls the recording thread too. Size regions
+	// to hold a frame's data, and Commit what was written so the rest of a region is reused.
+	class StreamVertexBuffer : public VertexBuffer
+	{
+	public:
+		// The next size bytes of the ring, starting at a whole vertex of the layout, so the
+		// draw reading them uses Offset / stride as its base vertex. Has to be written before
+		// the draws using it are submitted, and is not touched after.
+		virtual BufferSpan Map(uint32_t size) = 0;
+		// Only the first size bytes of the last Map were written, the rest of it goes back to
+		// the ring for the next Map. Has to come before that Map, without it the whole
+		// mapping stays used.
+		virtual void Commit(uint32_t size) = 0;
+
+		static Ref<StreamVertexBuffer> Create(uint32_t size);
+	};
+
+	class StreamIndexBuffer : public IndexBuffer
+	{
+	public:
+		// count indices, the draw reading them starts at index Offset / sizeof(uint32_t)
+		virtual BufferSpan Map(uint32_t count) = 0;
+
+		// count per region
+		static Ref<StreamIndexBuffer> Create(uint32_t count);
+	};
+
 };
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include "hzpch.h"
+#include "DrawQueue.h"
+
+namespace Hazel {
+
+	uint64_t DrawQueue::MakeKey(Pass pass, uint16_t shader, uint16_t material, float depth)
+	{
+		// the bits of a positive float sort like the float itself, the sign bit is always 0
+		// here so the other 31 fit in 30 bits by dropping the lowest mantissa bit
+		depth = std::max(depth, 0.0f);
+		uint32_t depthBits;
+		memcpy(&depthBits, &depth, sizeof(depthBits));
+		uint64_t depthKey = depthBits >> 1;
+
+		uint64_t key = (uint64_t)pass << 62;
+		if (pass == Pass::Opaque)
+			return key | (uint64_t)shader << 46 | (uint64_t)material << 30 | depthKey;
+
+		// farthest first
+		depthKey = ~depthKey & 0x3fffffff;
+		return key | depthKey << 32 | (uint64_t)shader << 16 | material;
+	}
+
+	void DrawQueue::Push(uint64_t key, Item&& item)
+	{
+		m_Order.push_back({ key, (uint32_t)m_Items.size() });
+		m_Items.push_back(std::move(item));
+	}
+
+	void DrawQueue::Sort()
+	{
+		HZ_PROFILE_FUNCTION();
+		if (m_Order.empty())
+			return;
+
+		// least significant byte first, every pass is stable
+		m_Scratch.resize(m_Order.size());
+		for (uint32_t shift = 0; shift < 64; shift += 8)
+		{
+			std::array<uint32_t, 256> offsets = {};
+			for (const Entry& entry : m_Order)
+				offsets[(entry.Key >> shift) & 0xff]++;
+
+			// all keys share this byte, e.g. the upper depth bits or unused ids
+			if (offsets[(m_Order[0].Key >> shift) & 0xff] == m_Order.size())
+				continue;
+
+			uint32_t offset = 0;
+			for (uint32_t& count : offsets)
+			{
+				uint32_t start = offset;
+				offset += count;
+				count = start;
+			}
+
+			for (const Entry& entry : m_Order)
+				m_Scratch[offsets[(entry.Key >> shift) & 0xff]++] = entry;
+			m_Order.swap(m_Scratch);
+		}
+	}
+
+	void DrawQueue::Clear()
+	{
+		m_Items.clear();
+		m_Order.clear();
+	}
+
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Shader.h"
+#include "Texture.h"
+#include "VertexArray.h"
+
+#include <glm/glm.hpp>
+
+namespace Hazel {
+
+	// State a queued draw sets besides its shader
+	struct DrawMaterial
+	{
+		Ref<Hazel::Texture> Texture;       // bound to slot 0
+		glm::vec4 Color = glm::vec4(1.0f); // uploaded as u_Color
+		bool Blended = false;              // drawn after every opaque draw, back to front
+	};
+
+	// Draws collected over a scene, run in the order of a 64-bit sort key rather than the order
+	// they were pushed in. From the most significant bit:
+	//   opaque:  pass (2) | shader (16) | material (16) | depth (30), front to back
+	//   blended: pass (2) | depth (30), back to front | shader (16) | material (16)
+	// Opaque draws end up grouped by state, blended ones in the order blending needs.
+	class DrawQueue
+	{
+	public:
+		enum class Pass : uint8_t
+		{
+			Opaque = 0, Blended = 1
+		};
+
+		struct Item
+		{
+			Ref<Hazel::Shader> Shader;
+			Ref<Hazel::VertexArray> VertexArray;
+			glm::mat4 Transform;
+			DrawMaterial Material;
+		};
+
+		// shader and material are small ids, depth the view space distance (negative counts as 0)
+		static uint64_t MakeKey(Pass pass, uint16_t shader, uint16_t material, float depth);
+		static Pass GetPass(uint64_t key) { return (Pass)(key >> 62); }
+
+		void Push(uint64_t key, Item&& item);
+		// radix sort, items with equal keys keep the order they were pushed in
+		void Sort();
+		void Clear();
+
+		uint32_t GetSize() const { return (uint32_t)m_Items.size(); }
+
+		// in key order once sorted
+		template<typename F>
+		void ForEach(Pass pass, F&& func) const
+		{
+			for (const Entry& entry : m_Order)
+			{
+				if (GetPass(entry.Key) == pass)
+					func(m_Items[entry.Index]);
+			}
+		}
+	private:
+		struct Entry
+		{
+			uint64_t Key;
+			uint32_t Index;
+		};
+
+		std::vector<Item> m_Items;
+		std::vector<Entry> m_Order;
+		std::vector<Entry> m_Scratch;
+	};
+
+}
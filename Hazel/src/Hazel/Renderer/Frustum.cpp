@@ -0,0 +1,130 @@
+#include "hzpch.h"
+#include "Frustum.h"
+
+#include "Hazel/Core/JobSystem.h"
+
+#if defined(_M_X64) || defined(__SSE2__)
+	#include <xmmintrin.h>
+	#define HZ_FRUSTUM_SSE 1
+#else
+	#define HZ_FRUSTUM_SSE 0
+#endif
+
+namespace Hazel {
+
+	Frustum::Frustum(const glm::mat4& projectionView)
+	{
+		// a point is inside when -w <= x, y, z <= w in clip space, each comparison is a plane
+		glm::vec4 x = glm::vec4(projectionView[0][0], projectionView[1][0], projectionView[2][0], projectionView[3][0]);
+		glm::vec4 y = glm::vec4(projectionView[0][1], projectionView[1][1], projectionView[2][1], projectionView[3][1]);
+		glm::vec4 z = glm::vec4(projectionView[0][2], projectionView[1][2], projectionView[2][2], projectionView[3][2]);
+		glm::vec4 w = glm::vec4(projectionView[0][3], projectionView[1][3], projectionView[2][3], projectionView[3][3]);
+
+		m_Planes = { w + x, w - x, w + y, w - y, w + z, w - z };
+		for (glm::vec4& plane : m_Planes)
+			plane /= glm::length(glm::vec3(plane));
+	}
+
+	bool Frustum::Intersects(const AABB& box) const
+	{
+		for (const glm::vec4& plane : m_Planes)
+		{
+			// the corner farthest along the normal, if it is behind the plane the whole box is
+			glm::vec3 corner = glm::vec3(
+				plane.x >= 0.0f ? box.Max.x : box.Min.x,
+				plane.y >= 0.0f ? box.Max.y : box.Min.y,
+				plane.z >= 0.0f ? box.Max.z : box.Min.z);
+			if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.0f)
+				return false;
+		}
+		return true;
+	}
+
+	void AABBList::Add(const AABB& box)
+	{
+		m_MinX.push_back(box.Min.x);
+		m_MinY.push_back(box.Min.y);
+		m_MinZ.push_back(box.Min.z);
+		m_MaxX.push_back(box.Max.x);
+		m_MaxY.push_back(box.Max.y);
+		m_MaxZ.push_back(box.Max.z);
+	}
+
+	void AABBList::Clear()
+	{
+		m_MinX.clear();
+		m_MinY.clear();
+		m_MinZ.clear();
+		m_MaxX.clear();
+		m_MaxY.clear();
+		m_MaxZ.clear();
+	}
+
+	uint32_t AABBList::Cull(const Frustum& frustum, std::vector<uint8_t>& visible) const
+	{
+		HZ_PROFILE_FUNCTION();
+		visible.resize(GetSize());
+
+		std::atomic<uint32_t> visibleCount = 0;
+		JobSystem::ParallelFor(GetSize(), CullBatchSize, [&](uint32_t begin, uint32_t end)
+		{
+			visibleCount += CullRange(frustum, begin, end, visible.data());
+		});
+		return visibleCount;
+	}
+
+	uint32_t AABBList::CullRange(const Frustum& frustum, uint32_t begin, uint32_t end, uint8_t* visible) const
+	{
+		const std::array<glm::vec4, 6>& planes = frustum.GetPlanes();
+		uint32_t visibleCount = 0;
+		uint32_t i = begin;
+
+#if HZ_FRUSTUM_SSE
+		// which of min and max is the farthest corner only depends on the plane, not on the box
+		const float* cornerX[6];
+		const float* cornerY[6];
+		const float* cornerZ[6];
+		__m128 planeX[6], planeY[6], planeZ[6], planeW[6];
+		for (size_t p = 0; p < planes.size(); p++)
+		{
+			cornerX[p] = planes[p].x >= 0.0f ? m_MaxX.data() : m_MinX.data();
+			cornerY[p] = planes[p].y >= 0.0f ? m_MaxY.data() : m_MinY.data();
+			cornerZ[p] = planes[p].z >= 0.0f ? m_MaxZ.data() : m_MinZ.data();
+			planeX[p] = _mm_set1_ps(planes[p].x);
+			planeY[p] = _mm_set1_ps(planes[p].y);
+			planeZ[p] = _mm_set1_ps(planes[p].z);
+			planeW[p] = _mm_set1_ps(planes[p].w);
+		}
+
+		const __m128 zero = _mm_setzero_ps();
+		for (; i + 4 <= end; i += 4)
+		{
+			__m128 outside = zero;
+			for (size_t p = 0; p < planes.size(); p++)
+			{
+				__m128 distance = _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(cornerX[p] + i), planeX[p]), _mm_mul_ps(_mm_loadu_ps(cornerY[p] + i), planeY[p])),
+					_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(cornerZ[p] + i), planeZ[p]), planeW[p]));
+				outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, zero));
+			}
+
+			int mask = _mm_movemask_ps(outside);
+			for (uint32_t lane = 0; lane < 4; lane++)
+			{
+				visible[i + lane] = (mask & (1 << lane)) ? 0 : 1;
+				visibleCount += visible[i + lane];
+			}
+		}
+#endif
+
+		// whatever does not fill a group of four
+		for (; i < end; i++)
+		{
+			AABB box = { { m_MinX[i], m_MinY[i], m_MinZ[i] }, { m_MaxX[i], m_MaxY[i], m_MaxZ[i] } };
+			visible[i] = frustum.Intersects(box) ? 1 : 0;
+			visibleCount += visible[i];
+		}
+		return visibleCount;
+	}
+
+}
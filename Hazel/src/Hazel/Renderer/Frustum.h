@@ -0,0 +1,51 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace Hazel {
+
+	struct AABB
+	{
+		glm::vec3 Min;
+		glm::vec3 Max;
+	};
+
+	// The six planes bounding what a projection view matrix can see, normals pointing inwards
+	class Frustum
+	{
+	public:
+		Frustum() = default; // sees everything
+		// OpenGL clip space, z from -w to w
+		Frustum(const glm::mat4& projectionView);
+
+		// conservative, a box next to a corner of the frustum can pass without touching it
+		bool Intersects(const AABB& box) const;
+
+		const std::array<glm::vec4, 6>& GetPlanes() const { return m_Planes; }
+	private:
+		std::array<glm::vec4, 6> m_Planes = {};
+	};
+
+	// Boxes stored as one array per coordinate, so they can be tested four at a time
+	class AABBList
+	{
+	public:
+		// lists longer than this are culled on the job system, one batch per job
+		static constexpr uint32_t CullBatchSize = 4096;
+
+		void Add(const AABB& box);
+		void Clear();
+
+		uint32_t GetSize() const { return (uint32_t)m_MinX.size(); }
+
+		// visible[i] becomes 1 for every box intersecting the frustum and 0 for the others,
+		// returns the number of visible boxes
+		uint32_t Cull(const Frustum& frustum, std::vector<uint8_t>& visible) const;
+	private:
+		uint32_t CullRange(const Frustum& frustum, uint32_t begin, uint32_t end, uint8_t* visible) const;
+	private:
+		std::vector<float> m_MinX, m_MinY, m_MinZ;
+		std::vector<float> m_MaxX, m_MaxY, m_MaxZ;
+	};
+
+}
@@ -0,0 +1,27 @@
+#include "hzpch.h"
+#include "GPUTimer.h"
+
+#include "Renderer.h"
+#include "Platform/OpenGL/OpenGLGPUTimer.h"
+#include "Platform/Null/NullGPUTimer.h"
+
+namespace Hazel {
+
+    Ref<GPUTimer> GPUTimer::Create()
+    {
+        switch (Renderer::GetAPI())
+        {
+        case RendererAPI::API::None:
+            HZ_CORE_ASSERT(false, "RendererAPI::None is not supported!");
+            return nullptr;
+        case RendererAPI::API::OpenGL:
+            return CreateRef<OpenGLGPUTimer>();
+        case RendererAPI::API::Null:
+            return CreateRef<NullGPUTimer>();
+        }
+
+        HZ_CORE_ASSERT(false, "Unknown renderer API!");
+        return nullptr;
+    }
+
+}
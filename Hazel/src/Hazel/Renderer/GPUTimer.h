@@ -0,0 +1,21 @@
+#pragma once
+
+namespace Hazel {
+
+	// Measures GPU time between Begin and End without stalling: results are read back
+	// once the GPU is done, so GetElapsedMillis reports a pass from a frame or two ago.
+	// Timers cannot be nested or overlap.
+	class GPUTimer
+	{
+	public:
+		virtual ~GPUTimer() {}
+
+		virtual void Begin() = 0;
+		virtual void End() = 0;
+
+		virtual float GetElapsedMillis() const = 0;
+
+		static Ref<GPUTimer> Create();
+	};
+
+}
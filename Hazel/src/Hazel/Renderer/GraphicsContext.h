@@ -7,6 +7,10 @@ namespace Hazel {
 	public:
 		virtual void Init() = 0;
 		virtual void SwapBuffers() = 0;
+
+		// binds the context to the calling thread, or unbinds it so another thread can take it
+		virtual void MakeCurrent() = 0;
+		virtual void ReleaseCurrent() = 0;
 	};
 
 }
\ No newline at end of file
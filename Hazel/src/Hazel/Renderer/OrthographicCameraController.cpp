@@ -58,9 +58,10 @@ namespace Hazel {
 	void OrthographicCameraController::OnEvent(Event& e)
 	{
 		HZ_PROFILE_FUNCTION();
-		EventDispacher dispacher(e);
-		dispacher.Dispach<MouseScrolledEvent>(HZ_BIND_EVENT_FN(OrthographicCameraController::OnMouseScrolled));
-		dispacher.Dispach<WindowResizeEvent>(HZ_BIND_EVENT_FN(OrthographicCameraController::OnWindowResize));
+		static const EventHandlerTable<OrthographicCameraController> s_Handlers = EventHandlerTable<OrthographicCameraController>()
+			.On<MouseScrolledEvent, &OrthographicCameraController::OnMouseScrolled>()
+			.On<WindowResizeEvent, &OrthographicCameraController::OnWindowResize>();
+		s_Handlers.Dispach(this, e);
 	}
 
 	bool OrthographicCameraController::OnMouseScrolled(MouseScrolledEvent& e)
@@ -47,8 +47,9 @@ namespace Hazel {
 
 	void PerspectiveCameraController::OnEvent(Event& e)
 	{
-		EventDispacher dispacher(e);
-		dispacher.Dispach<MouseMovedEvent>(HZ_BIND_EVENT_FN(PerspectiveCameraController::OnMouseMoved));
+		static const EventHandlerTable<PerspectiveCameraController> s_Handlers = EventHandlerTable<PerspectiveCameraController>()
+			.On<MouseMovedEvent, &PerspectiveCameraController::OnMouseMoved>();
+		s_Handlers.Dispach(this, e);
 	}
 
 	bool PerspectiveCameraController::OnMouseMoved(MouseMovedEvent& e)
@@ -1,10 +1,15 @@
 #include "hzpch.h"
 #include "RenderCommand.h"
 
-#include "Platform/OpenGL/OpenGLRendererAPI.h"
-
 namespace Hazel {
 
-	RendererAPI* RenderCommand::s_RendererAPI = new OpenGLRendererAPI;
+	Scope<RendererAPI> RenderCommand::s_RendererAPI;
+
+	void RenderCommand::Init()
+	{
+		// created here rather than statically so the API can be picked at startup
+		s_RendererAPI = RendererAPI::Create();
+		s_RendererAPI->Init();
+	}
 
 }
\ No newline at end of file
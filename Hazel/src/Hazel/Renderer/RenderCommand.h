@@ -7,7 +7,7 @@ namespace Hazel {
 	class RenderCommand
 	{
 	public:
-		inline static void Init() { s_RendererAPI->Init(); }
+		static void Init();
 		inline static void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) { s_RendererAPI->SetViewport(x, y, width, height); }
 		inline static void SetClearColor(const glm::vec4& color) { s_RendererAPI->SetClearColor(color); }
 		inline static void Clear() { s_RendererAPI->Clear(); }
@@ -15,9 +15,18 @@ namespace Hazel {
 		inline static void SetDepthFuncLessThanOrEqualTo() { s_RendererAPI->SetDepthFuncLessThanOrEqualTo(); }
 		inline static void SetDepthFuncLessThan() { s_RendererAPI->SetDepthFuncLessThan(); }
 
-		inline static void DrawIndexed(const Ref<VertexArray>& vertexArray) { s_RendererAPI->DrawIndexed(vertexArray); }
+		inline static void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0, uint32_t firstIndex = 0, uint32_t baseVertex = 0)
+		{
+			s_RendererAPI->DrawIndexed(vertexArray, indexCount, firstIndex, baseVertex);
+		}
+		inline static void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t instanceCount, uint32_t indexCount = 0, uint32_t baseInstance = 0)
+		{
+			s_RendererAPI->DrawIndexedInstanced(vertexArray, instanceCount, indexCount, baseInstance);
+		}
+
+		inline static uint32_t GetMaxTextureSlots() { return s_RendererAPI->GetMaxTextureSlots(); }
 	private:
-		static RendererAPI* s_RendererAPI;
+		static Scope<RendererAPI> s_RendererAPI;
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include "hzpch.h"
+#include "RenderCommandQueue.h"
+
+namespace Hazel {
+
+	RenderCommandQueue::~RenderCommandQueue()
+	{
+		Clear();
+	}
+
+	void* RenderCommandQueue::Allocate(size_t size, size_t alignment)
+	{
+		HZ_CORE_ASSERT(alignment <= alignof(std::max_align_t), "Render command data is over-aligned!");
+
+		m_Offset = (m_Offset + alignment - 1) & ~(alignment - 1);
+		if (m_BlockIndex < m_Blocks.size() && m_Offset + size > m_Blocks[m_BlockIndex].Size)
+		{
+			m_BlockIndex++;
+			m_Offset = 0;
+		}
+		// blocks are kept across frames, a new one is only needed the first time a frame gets
+		// this busy, or for data larger than any block so far
+		if (m_BlockIndex == m_Blocks.size() || size > m_Blocks[m_BlockIndex].Size)
+		{
+			size_t blockSize = std::max(size, BlockSize);
+			m_Blocks.insert(m_Blocks.begin() + m_BlockIndex, { Scope<uint8_t[]>(new uint8_t[blockSize]), blockSize });
+		}
+
+		void* memory = m_Blocks[m_BlockIndex].Memory.get() + m_Offset;
+		m_Offset += size;
+		m_Size += size;
+		return memory;
+	}
+
+	void RenderCommandQueue::Execute()
+	{
+		HZ_PROFILE_FUNCTION();
+		for (const Command& command : m_Commands)
+			command.Func(command.Memory, true);
+		Reset();
+	}
+
+	void RenderCommandQueue::Clear()
+	{
+		for (const Command& command : m_Commands)
+			command.Func(command.Memory, false);
+		Reset();
+	}
+
+	void RenderCommandQueue::Reset()
+	{
+		m_Commands.clear();
+		m_BlockIndex = 0;
+		m_Offset = 0;
+		m_Size = 0;
+	}
+
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+
+namespace Hazel {
+
+	// Linear buffer of recorded render commands. Commands are callables moved into a
+	// block arena, together with any data they need, and run in submission order by
+	// Execute. Blocks are kept and reused once the queue ran.
+	class RenderCommandQueue
+	{
+	public:
+		RenderCommandQueue() = default;
+		~RenderCommandQueue();
+		RenderCommandQueue(const RenderCommandQueue&) = delete;
+		RenderCommandQueue& operator=(const RenderCommandQueue&) = delete;
+
+		template<typename F>
+		void Submit(F&& func)
+		{
+			using Command = std::decay_t<F>;
+			static_assert(alignof(Command) <= alignof(std::max_align_t), "Render command is over-aligned!");
+
+			void* memory = Allocate(sizeof(Command), alignof(Command));
+			new (memory) Command(std::forward<F>(func));
+			m_Commands.push_back({ [](void* command, bool execute)
+			{
+				Command& typed = *static_cast<Command*>(command);
+				if (execute)
+					typed();
+				typed.~Command();
+			}, memory });
+		}
+
+		// Scratch memory for command data, valid until the queue ran
+		void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+		// runs every command in submission order and empties the queue
+		void Execute();
+		// destroys every command without running it
+		void Clear();
+
+		uint32_t GetCommandCount() const { return (uint32_t)m_Commands.size(); }
+		// bytes taken by the commands and their data
+		size_t GetSize() const { return m_Size; }
+	private:
+		void Reset();
+	private:
+		struct Command
+		{
+			void (*Func)(void* command, bool execute);
+			void* Memory;
+		};
+
+		struct Block
+		{
+			Scope<uint8_t[]> Memory;
+			size_t Size;
+		};
+
+		static constexpr size_t BlockSize = 256 * 1024;
+
+		std::vector<Block> m_Blocks;
+		size_t m_BlockIndex = 0;
+		size_t m_Offset = 0;
+		size_t m_Size = 0;
+
+		std::vector<Command> m_Commands;
+	};
+
+}
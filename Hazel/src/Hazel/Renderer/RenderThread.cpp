@@ -0,0 +1,184 @@
+#include "hzpch.h"
+#include "RenderThread.h"
+
+#include "GraphicsContext.h"
+#include "Hazel/Core/Timer.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Hazel {
+
+	struct RenderThreadData
+	{
+		std::thread Thread;
+		std::thread::id RecordingThreadID;
+		GraphicsContext* Context = nullptr;
+		std::atomic<bool> Running = false;
+
+		// the recording thread fills one queue while the render thread runs the other
+		std::array<RenderCommandQueue, 2> Queues;
+		uint32_t RecordingIndex = 0;
+
+		std::mutex Mutex;
+		std::condition_variable Condition;
+		bool Pending = false; // a queue was handed over and did not run yet
+		bool Stopping = false;
+
+		RenderThread::Statistics Recorded; // of the frame being recorded
+		RenderThread::Statistics Stats;
+		float ExecuteMillis = 0.0f;
+	};
+
+	static RenderThreadData s_Data;
+	static thread_local bool t_IsRenderThread = false;
+
+	void RenderThread::Start(GraphicsContext& context)
+	{
+		HZ_PROFILE_FUNCTION();
+		HZ_CORE_ASSERT(!s_Data.Running, "Render thread is already running!");
+
+		// a context can only be current on one thread at a time
+		context.ReleaseCurrent();
+
+		s_Data.Context = &context;
+		s_Data.RecordingThreadID = std::this_thread::get_id();
+		s_Data.Stopping = false;
+		s_Data.Running = true;
+		s_Data.Thread = std::thread(ThreadLoop, &context);
+		HZ_CORE_INFO("Render thread started");
+	}
+
+	void RenderThread::Stop()
+	{
+		HZ_PROFILE_FUNCTION();
+		if (!s_Data.Running)
+			return;
+
+		Flush();
+		{
+			std::lock_guard<std::mutex> lock(s_Data.Mutex);
+			s_Data.Stopping = true;
+		}
+		s_Data.Condition.notify_all();
+		s_Data.Thread.join();
+
+		s_Data.Running = false;
+		s_Data.Context->MakeCurrent();
+		s_Data.Context = nullptr;
+		HZ_CORE_INFO("Render thread stopped");
+	}
+
+	bool RenderThread::IsRunning()
+	{
+		return s_Data.Running;
+	}
+
+	bool RenderThread::IsRenderThread()
+	{
+		return t_IsRenderThread || !s_Data.Running;
+	}
+
+	const void* RenderThread::CopyCommandData(const void* data, size_t size)
+	{
+		if (IsRenderThread())
+			return data;
+
+		void* copy = GetRecordingQueue().Allocate(size);
+		memcpy(copy, data, size);
+		return copy;
+	}
+
+	void RenderThread::EndFrame()
+	{
+		if (!s_Data.Running)
+			return;
+
+		HZ_PROFILE_FUNCTION();
+		HandOver();
+
+		std::lock_guard<std::mutex> lock(s_Data.Mutex);
+		s_Data.Stats = s_Data.Recorded;
+		s_Data.Stats.ExecuteMillis = s_Data.ExecuteMillis;
+		s_Data.Recorded = {};
+	}
+
+	void RenderThread::Flush()
+	{
+		if (!s_Data.Running)
+			return;
+
+		HZ_PROFILE_FUNCTION();
+		HandOver();
+
+		Timer timer;
+		std::unique_lock<std::mutex> lock(s_Data.Mutex);
+		s_Data.Condition.wait(lock, [] { return !s_Data.Pending; });
+		s_Data.Recorded.WaitMillis += timer.ElapsedMillis();
+	}
+
+	RenderThread::Statistics RenderThread::GetStats()
+	{
+		std::lock_guard<std::mutex> lock(s_Data.Mutex);
+		return s_Data.Stats;
+	}
+
+	RenderCommandQueue& RenderThread::GetRecordingQueue()
+	{
+		HZ_CORE_ASSERT(std::this_thread::get_id() == s_Data.RecordingThreadID, "Render commands can only be recorded by the thread that started the render thread!");
+		return s_Data.Queues[s_Data.RecordingIndex];
+	}
+
+	void RenderThread::HandOver()
+	{
+		RenderCommandQueue& queue = GetRecordingQueue();
+		s_Data.Recorded.Commands += queue.GetCommandCount();
+		s_Data.Recorded.CommandBytes += queue.GetSize();
+
+		Timer timer;
+		{
+			// the render thread is never more than one hand over behind
+			std::unique_lock<std::mutex> lock(s_Data.Mutex);
+			s_Data.Condition.wait(lock, [] { return !s_Data.Pending; });
+			s_Data.Recorded.WaitMillis += timer.ElapsedMillis();
+
+			s_Data.RecordingIndex ^= 1;
+			s_Data.Pending = true;
+		}
+		s_Data.Condition.notify_all();
+	}
+
+	void RenderThread::ThreadLoop(GraphicsContext* context)
+	{
+		t_IsRenderThread = true;
+		context->MakeCurrent();
+
+		while (true)
+		{
+			uint32_t index;
+			{
+				std::unique_lock<std::mutex> lock(s_Data.Mutex);
+				s_Data.Condition.wait(lock, [] { return s_Data.Pending || s_Data.Stopping; });
+				if (!s_Data.Pending)
+					break; // Stop flushed everything before asking
+				index = s_Data.RecordingIndex ^ 1;
+			}
+
+			Timer timer;
+			s_Data.Queues[index].Execute();
+
+			{
+				std::lock_guard<std::mutex> lock(s_Data.Mutex);
+				s_Data.Pending = false;
+				s_Data.ExecuteMillis = timer.ElapsedMillis();
+			}
+			s_Data.Condition.notify_all();
+		}
+
+		context->ReleaseCurrent();
+		t_IsRenderThread = false;
+	}
+
+}
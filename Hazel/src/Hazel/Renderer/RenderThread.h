@@ -0,0 +1,70 @@
+#pragma once
+
+#include "RenderCommandQueue.h"
+
+#include <atomic>
+
+namespace Hazel {
+
+	class GraphicsContext;
+
+	// Name of a GPU object whose creation may still be waiting in the command queue. The
+	// render thread fills it in when the creation command runs, until then it reads 0.
+	// Commands hold on to the Ref, so the name outlives the resource that owns it.
+	using RendererHandle = Ref<std::atomic<uint32_t>>;
+
+	inline RendererHandle CreateRendererHandle()
+	{
+		return CreateRef<std::atomic<uint32_t>>(0u);
+	}
+
+	// Optional thread that owns the graphics context and replays the frame the main thread
+	// recorded before, so the two overlap. While it runs, the graphics backend records its
+	// calls through Submit instead of making them. Otherwise Submit runs the command right
+	// away, so code submitting commands does not need to know which mode it is in.
+	class RenderThread
+	{
+	public:
+		// Moves the context, current on the calling thread, to a new render thread.
+		// Only the calling thread may record commands from then on.
+		static void Start(GraphicsContext& context);
+		// Runs everything recorded so far and makes the context current on the calling thread again
+		static void Stop();
+		static bool IsRunning();
+		// true on the thread allowed to make graphics calls right now
+		static bool IsRenderThread();
+
+		template<typename F>
+		static void Submit(F&& func)
+		{
+			if (IsRenderThread())
+				func();
+			else
+				GetRecordingQueue().Submit(std::forward<F>(func));
+		}
+
+		// Copy of data for a submitted command to read, valid until the command ran.
+		// Returns data itself when commands run right away.
+		static const void* CopyCommandData(const void* data, size_t size);
+
+		// Hands the recorded frame over, after waiting for the render thread to finish the previous one
+		static void EndFrame();
+		// Hands over what has been recorded so far and waits until it ran, after which results
+		// written by those commands can be read. Stalls both threads, meant for resource creation.
+		static void Flush();
+
+		struct Statistics
+		{
+			uint32_t Commands = 0;      // recorded during the last frame
+			size_t CommandBytes = 0;
+			float ExecuteMillis = 0.0f; // last replay on the render thread
+			float WaitMillis = 0.0f;    // time the recording thread spent waiting for the render thread
+		};
+		static Statistics GetStats();
+	private:
+		static RenderCommandQueue& GetRecordingQueue();
+		static void HandOver();
+		static void ThreadLoop(GraphicsContext* context);
+	};
+
+}
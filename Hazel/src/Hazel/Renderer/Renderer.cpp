@@ -2,11 +2,219 @@
 #include "Renderer.h"
 #include "Platform/OpenGL/OpenGLShader.h"
 #include "Renderer2D.h"
+#include "TextureLoader.h"
 #include "glm/gtc/matrix_transform.hpp"
 
 namespace Hazel {
 
+	struct CubeInstance
+	{
+		glm::mat4 Transform;
+		glm::vec4 Color;
+	};
+
+	struct CubeInstances
+	{
+		Ref<TextureCubeMap> Texture; // none for colored cubes
+		std::vector<CubeInstance> Instances;
+		AABBList Bounds; // one per instance
+	};
+
+	struct CubeBatchData
+	{
+		// per draw call, and per region of the instance buffer so a scene this big fits in one
+		static constexpr uint32_t MaxInstances = 100000;
+
+		Ref<VertexArray> CubeVertexArray;
+		Ref<StreamVertexBuffer> InstanceBuffer;
+		Ref<Shader> ColoredShader;
+		Ref<Shader> TexturedShader;
+
+		CubeInstances Colored;
+		// one group per texture, kept while the texture is drawn with to reuse its memory
+		std::vector<CubeInstances> Textured;
+
+		Frustum ViewFrustum; // of the current scene
+		std::vector<uint8_t> Visible;
+		Renderer::Statistics Stats;
+	};
+
+	static CubeBatchData s_CubeBatch;
+
+	struct DrawQueueData
+	{
+		DrawQueue Queue;
+
+		// small ids for the sort keys, handed out in order of first use within a scene
+		std::unordered_map<const void*, uint16_t> ShaderIDs;
+		std::unordered_map<const void*, uint16_t> MaterialIDs;
+	};
+
+	static DrawQueueData s_DrawQueue;
+
+	static uint16_t GetSortID(std::unordered_map<const void*, uint16_t>& ids, const void* object)
+	{
+		return ids.emplace(object, (uint16_t)ids.size()).first->second;
+	}
+
+	static void DrawQueued(DrawQueue::Pass pass)
+	{
+		HZ_PROFILE_FUNCTION();
+		// consecutive draws mostly share their state after sorting, it is only set when it changes
+		const Shader* shader = nullptr;
+		const VertexArray* vertexArray = nullptr;
+		const Texture* texture = nullptr;
+		UniformHandle transformHandle = -1, colorHandle = -1;
+
+		s_DrawQueue.Queue.ForEach(pass, [&](const DrawQueue::Item& item)
+		{
+			if (item.Shader.get() != shader)
+			{
+				shader = item.Shader.get();
+				item.Shader->Bind();
+				transformHandle = item.Shader->GetUniformHandle("u_Transform");
+				colorHandle = item.Shader->GetUniformHandle("u_Color");
+			}
+			if (item.Material.Texture && item.Material.Texture.get() != texture)
+			{
+				texture = item.Material.Texture.get();
+				item.Material.Texture->Bind(0);
+			}
+			if (item.VertexArray.get() != vertexArray)
+			{
+				vertexArray = item.VertexArray.get();
+				item.VertexArray->Bind();
+			}
+
+			// shaders without the uniform have no use for it
+			if (transformHandle != -1)
+				item.Shader->SetMat4(transformHandle, item.Transform);
+			if (colorHandle != -1)
+				item.Shader->SetFloat4(colorHandle, item.Material.Color);
+			RenderCommand::DrawIndexed(item.VertexArray);
+		});
+	}
+
+	// drops the instances outside the view frustum, keeping the order of the others
+	static void CullCubes(CubeInstances& group)
+	{
+		uint32_t count = group.Bounds.GetSize();
+		uint32_t visibleCount = group.Bounds.Cull(s_CubeBatch.ViewFrustum, s_CubeBatch.Visible);
+		group.Bounds.Clear();
+
+		s_CubeBatch.Stats.VisibleCubes += visibleCount;
+		s_CubeBatch.Stats.CulledCubes += count - visibleCount;
+		if (visibleCount == count)
+			return;
+
+		size_t kept = 0;
+		for (size_t i = 0; i < group.Instances.size(); i++)
+		{
+			if (s_CubeBatch.Visible[i])
+				group.Instances[kept++] = group.Instances[i];
+		}
+		group.Instances.resize(kept);
+	}
+
+	static void DrawCubeInstances(const Ref<Shader>& shader, CubeInstances& group)
+	{
+		CullCubes(group);
+		if (group.Instances.empty())
+			return;
+
+		shader->Bind();
+		if (group.Texture)
+			group.Texture->Bind(0);
+		s_CubeBatch.CubeVertexArray->Bind();
+
+		for (size_t first = 0; first < group.Instances.size(); first += CubeBatchData::MaxInstances)
+		{
+			uint32_t count = (uint32_t)std::min<size_t>(group.Instances.size() - first, CubeBatchData::MaxInstances);
+			BufferSpan span = s_CubeBatch.InstanceBuffer->Map(count * sizeof(CubeInstance));
+			memcpy(span.Data, &group.Instances[first], span.Size);
+			RenderCommand::DrawIndexedInstanced(s_CubeBatch.CubeVertexArray, count, 0, span.Offset / sizeof(CubeInstance));
+		}
+
+		group.Instances.clear();
+	}
+
+	static void FlushCubes()
+	{
+		HZ_PROFILE_FUNCTION();
+		// textures no cube was drawn with this scene are let go
+		s_CubeBatch.Textured.erase(std::remove_if(s_CubeBatch.Textured.begin(), s_CubeBatch.Textured.end(),
+			[](const CubeInstances& group) { return group.Instances.empty(); }), s_CubeBatch.Textured.end());
+
+		DrawCubeInstances(s_CubeBatch.ColoredShader, s_CubeBatch.Colored);
+		for (CubeInstances& group : s_CubeBatch.Textured)
+			DrawCubeInstances(s_CubeBatch.TexturedShader, group);
+	}
+
+	static void InitCubeShaders()
+	{
+		// in strings like the Renderer2D shader, so clients do not need the files
+		const char* vertexSource = R"(
+#version 450 core
+
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in mat4 a_Transform; // per instance, takes locations 1 to 4
+layout(location = 5) in vec4 a_Color;     // per instance
+
+layout(std140, binding = 0) uniform Camera
+{
+	mat4 u_ProjectionView;
+	mat4 u_Projection;
+	mat4 u_View;
+	mat4 u_SkyboxView;
+};
+
+out vec3 v_Direction;
+out vec4 v_Color;
+
+void main()
+{
+	v_Direction = a_Position;
+	v_Color = a_Color;
+	gl_Position = u_ProjectionView * a_Transform * vec4(a_Position, 1.0);
+}
+)";
+
+		const char* coloredSource = R"(
+#version 450 core
+
+layout(location = 0) out vec4 color;
+
+in vec3 v_Direction;
+in vec4 v_Color;
+
+void main()
+{
+	color = v_Color;
+}
+)";
+
+		const char* texturedSource = R"(
+#version 450 core
+
+layout(location = 0) out vec4 color;
+
+in vec3 v_Direction;
+in vec4 v_Color;
+
+layout(binding = 0) uniform samplerCube u_Texture;
+
+void main()
+{
+	color = texture(u_Texture, v_Direction) * v_Color;
+}
+)";
+
+		s_CubeBatch.ColoredShader = Shader::Create("InstancedColoredCube", vertexSource, coloredSource);
+		s_CubeBatch.TexturedShader = Shader::Create("InstancedTexturedCube", vertexSource, texturedSource);
+	}
+
 	Ref<VertexArray> Renderer::s_VertexArray;
+	Ref<UniformBuffer> Renderer::s_CameraUniformBuffer;
 	ShaderLibrary Renderer::s_ShaderLibrary;
 
 	Renderer::SceneData* Renderer::s_SceneData = new Renderer::SceneData;
@@ -15,6 +223,8 @@ namespace Hazel {
 	{
 		HZ_PROFILE_FUNCTION();
 		RenderCommand::Init();
+
+		s_CameraUniformBuffer = UniformBuffer::Create(sizeof(CameraData), CameraBinding);
 		Renderer2D::Init();
 
 		s_VertexArray = Hazel::VertexArray::Create();
@@ -37,6 +247,16 @@ namespace Hazel {
 			});
 		s_VertexArray->AddVertexBuffer(vertexBuffer);
 
+		// the same cube, with the instance attributes after the position
+		s_CubeBatch.InstanceBuffer = StreamVertexBuffer::Create(CubeBatchData::MaxInstances * sizeof(CubeInstance));
+		s_CubeBatch.InstanceBuffer->SetLayout({
+			{ ShaderDataType::Mat4, "a_Transform", false, true },
+			{ ShaderDataType::Float4, "a_Color", false, true },
+			});
+		s_CubeBatch.CubeVertexArray = VertexArray::Create();
+		s_CubeBatch.CubeVertexArray->AddVertexBuffer(vertexBuffer);
+		s_CubeBatch.CubeVertexArray->AddVertexBuffer(s_CubeBatch.InstanceBuffer);
+
 		uint32_t indices[36] = {
 			0, 1, 2, 2, 3, 0, // front
 			4, 5, 6, 6, 7, 4, // rear
@@ -48,12 +268,24 @@ namespace Hazel {
 
 		auto indexBuffer = Hazel::IndexBuffer::Create(indices, sizeof(indices) / sizeof(uint32_t));
 		s_VertexArray->SetIndexBuffer(indexBuffer);
+		s_CubeBatch.CubeVertexArray->SetIndexBuffer(indexBuffer);
+
+		InitCubeShaders();
 
 		s_ShaderLibrary.Load("assets/shaders/VertexPos.glsl");
 		s_ShaderLibrary.Load("assets/shaders/Skybox.glsl");
 		s_ShaderLibrary.Load("assets/shaders/Textured3D.glsl");
 	}
 
+	void Renderer::Shutdown()
+	{
+		HZ_PROFILE_FUNCTION();
+		TextureLoader::Shutdown();
+		Renderer2D::Shutdown();
+		s_CubeBatch = CubeBatchData();
+		s_DrawQueue = DrawQueueData();
+	}
+
 	void Renderer::OnWindowResize(uint32_t width, uint32_t height)
 	{
 		RenderCommand::SetViewport(0, 0, width, height);
@@ -61,57 +293,99 @@ namespace Hazel {
 
 	void Renderer::BeginScene(const PerspectiveCamera& camera)
 	{
-		s_SceneData->ProjectionViewMatrix = camera.GetProjectionViewMatrix();
-		s_SceneData->ProjectionMatrix = camera.GetProjectionMatrix();
-		s_SceneData->ViewMatrix = camera.GetViewMatrix();
+		const glm::mat4& view = camera.GetViewMatrix();
+		SetCameraData({ camera.GetProjectionViewMatrix(), camera.GetProjectionMatrix(), view, glm::mat4(glm::mat3(view)) });
+		s_SceneData->View = view;
+		s_CubeBatch.ViewFrustum = Frustum(camera.GetProjectionViewMatrix());
 	}
 
 	void Renderer::EndScene()
 	{
+		HZ_PROFILE_FUNCTION();
+		s_DrawQueue.Queue.Sort();
+
+		DrawQueued(DrawQueue::Pass::Opaque);
+		FlushCubes();
 		DrawSkybox(s_SceneData->Skybox);
+		// over everything else, including the skybox
+		DrawQueued(DrawQueue::Pass::Blended);
+
+		s_DrawQueue.Queue.Clear();
+		s_DrawQueue.ShaderIDs.clear();
+		s_DrawQueue.MaterialIDs.clear();
 	}
 
-	void Renderer::Submit(const Ref<Shader>& shader, const Ref<VertexArray>& vertexArray, const glm::mat4 transform)
+	void Renderer::Submit(const Ref<Shader>& shader, const Ref<VertexArray>& vertexArray, const glm::mat4& transform, const DrawMaterial& material)
 	{
-		shader->Bind();
-		shader->SetMat4("u_ProjectionView", s_SceneData->ProjectionViewMatrix);
-		shader->SetMat4("u_Transform", transform);
+		// the camera looks down -z, the distance in front of it is -z in view space
+		float depth = -(s_SceneData->View * transform[3]).z;
+		DrawQueue::Pass pass = material.Blended ? DrawQueue::Pass::Blended : DrawQueue::Pass::Opaque;
+		uint16_t shaderID = GetSortID(s_DrawQueue.ShaderIDs, shader.get());
+		uint16_t materialID = GetSortID(s_DrawQueue.MaterialIDs, material.Texture.get());
 
-		vertexArray->Bind();
-		RenderCommand::DrawIndexed(vertexArray);
+		s_DrawQueue.Queue.Push(DrawQueue::MakeKey(pass, shaderID, materialID, depth), { shader, vertexArray, transform, material });
 	}
 
-	void Renderer::DrawColoredCube(const glm::vec3& position, const glm::vec4& color, const glm::vec3& size)
+	// T * S, without going through two matrix products
+	static glm::mat4 CubeTransform(const glm::vec3& position, const glm::vec3& size)
 	{
-		auto shader = s_ShaderLibrary.Get("VertexPos");
+		return glm::mat4(
+			glm::vec4(size.x, 0.0f, 0.0f, 0.0f),
+			glm::vec4(0.0f, size.y, 0.0f, 0.0f),
+			glm::vec4(0.0f, 0.0f, size.z, 0.0f),
+			glm::vec4(position, 1.0f));
+	}
 
-		shader->Bind();
-		shader->SetFloat4("u_Color", color);
+	// the cube mesh spans -1 to 1 on every axis
+	static AABB CubeBounds(const glm::vec3& position, const glm::vec3& size)
+	{
+		glm::vec3 extent = glm::abs(size);
+		return { position - extent, position + extent };
+	}
 
-		// T * S
-		auto tranform = glm::translate(glm::mat4(1.0f), position) * glm::scale(glm::mat4(1.0f), size);
-		Submit(shader, s_VertexArray, tranform);
+	void Renderer::DrawColoredCube(const glm::vec3& position, const glm::vec4& color, const glm::vec3& size)
+	{
+		s_CubeBatch.Colored.Instances.push_back({ CubeTransform(position, size), color });
+		s_CubeBatch.Colored.Bounds.Add(CubeBounds(position, size));
 	}
 
 	void Renderer::DrawTexturedCube(const glm::vec3& position, const Ref<TextureCubeMap>& texture, const glm::vec3& size)
 	{
-		texture->Bind(0);
+		// a scene rarely has more than a few cube textures, a linear search beats hashing
+		auto group = std::find_if(s_CubeBatch.Textured.begin(), s_CubeBatch.Textured.end(),
+			[&texture](const CubeInstances& group) { return group.Texture == texture; });
+		if (group == s_CubeBatch.Textured.end())
+			group = s_CubeBatch.Textured.insert(group, { texture, {}, {} });
+
+		group->Instances.push_back({ CubeTransform(position, size), glm::vec4(1.0f) });
+		group->Bounds.Add(CubeBounds(position, size));
+	}
+
+	void Renderer::ResetStats()
+	{
+		s_CubeBatch.Stats = Statistics();
+	}
 
-		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position);
-		Submit(s_ShaderLibrary.Get("Textured3D"), s_VertexArray, transform);
+	Renderer::Statistics Renderer::GetStats()
+	{
+		return s_CubeBatch.Stats;
 	}
 
 	void Renderer::DrawSkybox(const Ref<TextureCubeMap>& texture)
 	{
 		RenderCommand::SetDepthFuncLessThanOrEqualTo();
+		// the shader reads u_SkyboxView from the Camera block, the view matrix without its translation
 		auto shader = s_ShaderLibrary.Get("Skybox");
 		shader->Bind();
-		shader->SetMat4("u_Projection", s_SceneData->ProjectionMatrix);
-		shader->SetMat4("u_View", glm::mat4(glm::mat3(s_SceneData->ViewMatrix)));
 		s_VertexArray->Bind();
 		texture->Bind();
 		RenderCommand::DrawIndexed(s_VertexArray);
 		RenderCommand::SetDepthFuncLessThan();
 	}
 
+	void Renderer::SetCameraData(const CameraData& camera)
+	{
+		s_CameraUniformBuffer->SetData(&camera, sizeof(CameraData));
+	}
+
 }
\ No newline at end of file
@@ -4,6 +4,9 @@
 #include "PerspectiveCamera.h"
 #include "Shader.h"
 #include "Texture.h"
+#include "UniformBuffer.h"
+#include "DrawQueue.h"
+#include "Frustum.h"
 #include "glm/glm.hpp"
 
 namespace Hazel {
@@ -12,6 +15,7 @@ namespace Hazel {
 	{
 	public:
 		static void Init();
+		static void Shutdown();
 		static void OnWindowResize(uint32_t width, uint32_t height);
 
 		static void BeginScene(const PerspectiveCamera& camera);
@@ -20,25 +24,53 @@ namespace Hazel {
 		static inline void SetSkybox(const Ref<TextureCubeMap>& skybox) { s_SceneData->Skybox = skybox; }
 		static inline const Ref<TextureCubeMap>& GetSkybox() { return s_SceneData->Skybox; }
 		
-		static void Submit(const Ref<Shader>& shader, const Ref<VertexArray>& vertexArray, const glm::mat4 transform = glm::mat4(1.0f));
+		// Queued until EndScene, which sorts the queue to draw opaque submissions grouped by
+		// shader and material, front to back, and blended ones back to front after them.
+		// The shader gets the transform as u_Transform and the material color as u_Color.
+		static void Submit(const Ref<Shader>& shader, const Ref<VertexArray>& vertexArray, const glm::mat4& transform = glm::mat4(1.0f), const DrawMaterial& material = DrawMaterial());
 
+		// Cubes are collected until EndScene and drawn instanced there, one draw call per
+		// texture (and one for all colored cubes) rather than one per cube. Cubes outside
+		// the camera's frustum are left out.
 		static void DrawColoredCube(const glm::vec3& position, const glm::vec4& color, const glm::vec3& size);
 		static void DrawTexturedCube(const glm::vec3& position, const Ref<TextureCubeMap>& texture, const glm::vec3& size);
 
 		static void DrawSkybox(const Ref<TextureCubeMap>& texture);
 
+		// Stats
+		struct Statistics
+		{
+			uint32_t VisibleCubes = 0;
+			uint32_t CulledCubes = 0;
+		};
+		static void ResetStats();
+		static Statistics GetStats();
+
+		// Camera matrices shared by every shader through the std140 "Camera" uniform block:
+		// layout(std140, binding = 0) uniform Camera { mat4 u_ProjectionView; mat4 u_Projection; mat4 u_View; mat4 u_SkyboxView; };
+		struct CameraData
+		{
+			glm::mat4 ProjectionView;
+			glm::mat4 Projection;
+			glm::mat4 View;
+			glm::mat4 SkyboxView; // View without the translation, the skybox stays centered on the camera
+		};
+		static constexpr uint32_t CameraBinding = 0;
+
+		// Uploaded once per BeginScene, only one scene (2D or 3D) can be in flight at a time
+		static void SetCameraData(const CameraData& camera);
+
 		inline static RendererAPI::API GetAPI() { return RendererAPI::GetAPI(); }
 	private:
 		struct SceneData
 		{
-			glm::mat4 ProjectionViewMatrix;
-			glm::mat4 ProjectionMatrix;
-			glm::mat4 ViewMatrix;
 			Ref<TextureCubeMap> Skybox;
+			glm::mat4 View = glm::mat4(1.0f); // for the depth of queued draws
 		};
 
 		static SceneData* s_SceneData;
 		static Ref<VertexArray> s_VertexArray;
+		static Ref<UniformBuffer> s_CameraUniformBuffer;
 		static ShaderLibrary s_ShaderLibrary;
 	};
 
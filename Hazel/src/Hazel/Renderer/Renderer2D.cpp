@@ -1,5 +1,6 @@
 #include "hzpch.h"
 #include "Renderer2D.h"
+#include "Renderer.h"
 
 
 #include <glm/glm.hpp>
@@ -7,96 +8,389 @@
 
 namespace Hazel {
 
-	Ref<VertexArray> Renderer2D::s_QuadVertexArray;
-	Ref<Shader> Renderer2D::s_TextureShader;
-	Ref<Texture2D> Renderer2D::s_WhiteTexture;
+	struct QuadVertex
+	{
+		glm::vec3 Position;
+		glm::vec4 Color;
+		glm::vec2 TexCoord;
+		float TexIndex;
+		float TilingFactor;
+	};
+
+	struct Renderer2DData
+	{
+		static constexpr uint32_t MaxQuads = 10000;
+		static constexpr uint32_t MaxVertices = MaxQuads * 4;
+		static constexpr uint32_t MaxIndices = MaxQuads * 6;
+		static constexpr uint32_t BatchesPerRegion = 4; // full ones, smaller batches only use what they wrote
+		static constexpr uint32_t MaxTextureSlotsLimit = 32; // upper bound of the sampler table, whatever the hardware offers
+
+		Ref<VertexArray> QuadVertexArray;
+		Ref<StreamVertexBuffer> QuadVertexBuffer;
+		Ref<Shader> TextureShader;
+		Ref<Shader> TilemapShader;
+		Ref<Texture2D> WhiteTexture;
+
+		// the batch is written straight into the mapped vertex buffer
+		uint32_t QuadIndexCount = 0;
+		QuadVertex* QuadVertexBufferBase = nullptr;
+		QuadVertex* QuadVertexBufferPtr = nullptr;
+		uint32_t QuadBaseVertex = 0;
+
+		// textures referenced by the current batch, each vertex stores its slot index
+		uint32_t MaxTextureSlots = 0;
+		std::array<Ref<Texture>, MaxTextureSlotsLimit> TextureSlots;
+		uint32_t TextureSlotIndex = 1; // 0 = white texture
+
+		// world space rectangle the camera of the current scene sees, everything outside a scene is drawn
+		glm::vec2 ViewMin = glm::vec2(-FLT_MAX);
+		glm::vec2 ViewMax = glm::vec2(FLT_MAX);
+
+		Renderer2D::Statistics Stats;
+	};
+
+	static Renderer2DData s_Data;
+
+	// unit quad centered on the origin, in the same order as the indices expect
+	static const glm::vec2 s_QuadVertexPositions[4] = {
+		{ -0.5f, -0.5f }, // bottom left
+		{  0.5f, -0.5f }, // bottom right
+		{  0.5f,  0.5f }, // top right
+		{ -0.5f,  0.5f }, // top left
+	};
+
+	static const glm::vec2 s_QuadTexCoords[4] = {
+		{ 0.0f, 0.0f },
+		{ 1.0f, 0.0f },
+		{ 1.0f, 1.0f },
+		{ 0.0f, 1.0f },
+	};
+
+	static void StartBatch()
+	{
+		BufferSpan vertices = s_Data.QuadVertexBuffer->Map(Renderer2DData::MaxVertices * sizeof(QuadVertex));
+		s_Data.QuadVertexBufferBase = vertices.As<QuadVertex>();
+		s_Data.QuadBaseVertex = vertices.Offset / sizeof(QuadVertex);
+
+		s_Data.QuadIndexCount = 0;
+		s_Data.QuadVertexBufferPtr = s_Data.QuadVertexBufferBase;
+		s_Data.TextureSlotIndex = 1;
+	}
+
+	// the part of the mapping the batch did not write goes back to the vertex buffer
+	static void EndBatch()
+	{
+		Renderer2D::Flush();
+
+		uint32_t size = (uint32_t)((uint8_t*)s_Data.QuadVertexBufferPtr - (uint8_t*)s_Data.QuadVertexBufferBase);
+		s_Data.QuadVertexBuffer->Commit(size);
+	}
+
+	static void NextBatch()
+	{
+		EndBatch();
+		StartBatch();
+	}
+
+	// returns the slot of the texture in the current batch, adding it (and flushing if the table is full) when needed
+	static float GetTextureIndex(const Ref<Texture>& texture)
+	{
+		// textures are deduplicated by object, their GPU name may not exist yet when rendering on the render thread
+		for (uint32_t i = 0; i < s_Data.TextureSlotIndex; i++)
+		{
+			if (s_Data.TextureSlots[i] == texture)
+				return (float)i;
+		}
+
+		if (s_Data.TextureSlotIndex >= s_Data.MaxTextureSlots)
+			NextBatch();
+
+		float textureIndex = (float)s_Data.TextureSlotIndex;
+		s_Data.TextureSlots[s_Data.TextureSlotIndex] = texture;
+		s_Data.TextureSlotIndex++;
+		return textureIndex;
+	}
+
+	// writes an already transformed quad into the batch, flushing first if it cannot be added
+	static void SubmitQuad(const glm::vec3 positions[4], const glm::vec4& color, const Ref<Texture>& texture, float tilingFactor, const glm::vec2 texCoords[4] = s_QuadTexCoords)
+	{
+		if (s_Data.QuadIndexCount >= Renderer2DData::MaxIndices)
+			NextBatch();
+
+		const float textureIndex = GetTextureIndex(texture);
+
+		for (uint32_t i = 0; i < 4; i++)
+		{
+			s_Data.QuadVertexBufferPtr->Position = positions[i];
+			s_Data.QuadVertexBufferPtr->Color = color;
+			s_Data.QuadVertexBufferPtr->TexCoord = texCoords[i];
+			s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
+			s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
+			s_Data.QuadVertexBufferPtr++;
+		}
+
+		s_Data.QuadIndexCount += 6;
+		s_Data.Stats.QuadCount++;
+	}
+
+	// true when a quad reaching extent around its center misses the view, it is then counted as culled
+	static bool IsOutsideView(const glm::vec3& position, const glm::vec2& extent)
+	{
+		if (position.x + extent.x < s_Data.ViewMin.x || position.x - extent.x > s_Data.ViewMax.x ||
+			position.y + extent.y < s_Data.ViewMin.y || position.y - extent.y > s_Data.ViewMax.y)
+		{
+			s_Data.Stats.CulledQuads++;
+			return true;
+		}
+		return false;
+	}
+
+	// half the size, the extent of an axis aligned quad
+	static glm::vec2 QuadExtent(const glm::vec2& size)
+	{
+		return glm::abs(size) * 0.5f;
+	}
+
+	// the radius of the bounding circle, whatever the rotation
+	static glm::vec2 RotatedQuadExtent(const glm::vec2& size)
+	{
+		return glm::vec2(glm::length(size) * 0.5f);
+	}
+
+	// Translation * Scale, without going through a matrix
+	static void CalculateQuadPositions(const glm::vec3& position, const glm::vec2& size, glm::vec3 positions[4])
+	{
+		for (uint32_t i = 0; i < 4; i++)
+			positions[i] = { position.x + s_QuadVertexPositions[i].x * size.x, position.y + s_QuadVertexPositions[i].y * size.y, position.z };
+	}
+
+	// Translation * Rotation * Scale, without going through a matrix
+	static void CalculateRotatedQuadPositions(const glm::vec3& position, float rotation, const glm::vec2& size, glm::vec3 positions[4])
+	{
+		float c = glm::cos(rotation);
+		float s = glm::sin(rotation);
+		for (uint32_t i = 0; i < 4; i++)
+		{
+			float x = s_QuadVertexPositions[i].x * size.x;
+			float y = s_QuadVertexPositions[i].y * size.y;
+			positions[i] = { position.x + x * c - y * s, position.y + x * s + y * c, position.z };
+		}
+	}
 
 	void Renderer2D::Init()
 	{
 		HZ_PROFILE_FUNCTION();
-		s_QuadVertexArray = VertexArray::Create();
-
-		float squareVertecies[4 * 5] = { // create the vertecies on the stack
-			-0.5f, -0.5f, 0.0,		0.0f, 0.0f,	// bottom left
-			 0.5f, -0.5f, 0.0,		1.0f, 0.0f,	// bottom right
-			 0.5f,  0.5f, 0.0,		1.0f, 1.0f,	// top right
-			-0.5f,  0.5f, 0.0,		0.0f, 1.0f,	// top left
-		};
-
-		// uploading square vertecies to vram
-		Ref<VertexBuffer> squareVB = VertexBuffer::Create(squareVertecies, sizeof(squareVertecies));
-		squareVB->SetLayout({
+		s_Data.QuadVertexArray = VertexArray::Create();
+
+		// room for a few whole batches per region, a frame usually fits in one
+		s_Data.QuadVertexBuffer = StreamVertexBuffer::Create(Renderer2DData::BatchesPerRegion * Renderer2DData::MaxVertices * sizeof(QuadVertex));
+		s_Data.QuadVertexBuffer->SetLayout({
 			{ ShaderDataType::Float3, "a_Position" },
+			{ ShaderDataType::Float4, "a_Color" },
 			{ ShaderDataType::Float2, "a_TexCoord" },
+			{ ShaderDataType::Float, "a_TexIndex" },
+			{ ShaderDataType::Float, "a_TilingFactor" },
 			});
-		s_QuadVertexArray->AddVertexBuffer(squareVB);
+		s_Data.QuadVertexArray->AddVertexBuffer(s_Data.QuadVertexBuffer);
 
-		// uploading square indices to vram
-		uint32_t squareIndices[6] = { 0, 1, 2, 2, 3, 0 }; // create the indices on the stack
-		Ref<IndexBuffer> squareIB;
-		squareIB = IndexBuffer::Create(squareIndices, sizeof(squareIndices) / sizeof(uint32_t));
-		s_QuadVertexArray->SetIndexBuffer(squareIB);
+		// the indices never change so they are generated once for the whole buffer
+		uint32_t* quadIndices = new uint32_t[Renderer2DData::MaxIndices];
+		uint32_t offset = 0;
+		for (uint32_t i = 0; i < Renderer2DData::MaxIndices; i += 6)
+		{
+			quadIndices[i + 0] = offset + 0;
+			quadIndices[i + 1] = offset + 1;
+			quadIndices[i + 2] = offset + 2;
 
-		s_WhiteTexture = Texture2D::Create(1, 1);
+			quadIndices[i + 3] = offset + 2;
+			quadIndices[i + 4] = offset + 3;
+			quadIndices[i + 5] = offset + 0;
+
+			offset += 4;
+		}
+
+		Ref<IndexBuffer> quadIB = IndexBuffer::Create(quadIndices, Renderer2DData::MaxIndices);
+		s_Data.QuadVertexArray->SetIndexBuffer(quadIB);
+		delete[] quadIndices;
+
+		s_Data.WhiteTexture = Texture2D::Create(1, 1);
 		uint32_t whiteTextureData = 0xffffffff;
-		s_WhiteTexture->SetData(&whiteTextureData, 4);
+		s_Data.WhiteTexture->SetData(&whiteTextureData, 4);
+		s_Data.TextureSlots[0] = s_Data.WhiteTexture;
+
+		s_Data.MaxTextureSlots = std::min(RenderCommand::GetMaxTextureSlots(), Renderer2DData::MaxTextureSlotsLimit);
+		HZ_CORE_INFO("Renderer2D batches up to {0} textures per draw call", s_Data.MaxTextureSlots);
 
 		// in a string to avoid forcing the client to have the shaders installed
 		auto vSource = R"(
-#version 330 core
-			
+#version 450 core
+
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec4 a_Color;
+layout(location = 2) in vec2 a_TexCoord;
+layout(location = 3) in float a_TexIndex;
+layout(location = 4) in float a_TilingFactor;
+
+layout(std140, binding = 0) uniform Camera
+{
+	mat4 u_ProjectionView;
+	mat4 u_Projection;
+	mat4 u_View;
+	mat4 u_SkyboxView;
+};
+
+out vec4 v_Color;
+out vec2 v_TexCoord;
+flat out int v_TexIndex;
+out float v_TilingFactor;
+
+void main()
+{
+	v_Color = a_Color;
+	v_TexCoord = a_TexCoord;
+	v_TexIndex = int(a_TexIndex);
+	v_TilingFactor = a_TilingFactor;
+	gl_Position = u_ProjectionView * vec4(a_Position, 1.0);
+}
+)";
+
+		// sampler arrays may only be indexed with dynamically uniform expressions and the texture index
+		// varies per quad, so the fragment shader picks the sampler through a switch generated for the slot count
+		std::stringstream fSource;
+		fSource << R"(
+#version 450 core
+
+layout(location = 0) out vec4 color;
+
+in vec4 v_Color;
+in vec2 v_TexCoord;
+flat in int v_TexIndex;
+in float v_TilingFactor;
+)";
+		fSource << "uniform sampler2D u_Textures[" << s_Data.MaxTextureSlots << "];\n";
+		fSource << R"(
+void main()
+{
+	vec2 texCoord = v_TexCoord * v_TilingFactor;
+	vec4 texColor = vec4(1.0);
+	switch (v_TexIndex)
+	{
+)";
+		for (uint32_t i = 0; i < s_Data.MaxTextureSlots; i++)
+			fSource << "\t\tcase " << i << ": texColor = texture(u_Textures[" << i << "], texCoord); break;\n";
+		fSource << R"(	}
+	color = v_Color * texColor;
+}
+)";
+
+		s_Data.TextureShader = Shader::Create("Texture", vSource, fSource.str());
+
+		int samplers[Renderer2DData::MaxTextureSlotsLimit];
+		for (uint32_t i = 0; i < Renderer2DData::MaxTextureSlotsLimit; i++)
+			samplers[i] = i;
+
+		s_Data.TextureShader->Bind();
+		s_Data.TextureShader->SetIntArray("u_Textures", samplers, s_Data.MaxTextureSlots);
+
+		// tilemap chunks only carry a position and the texture coordinates into their atlas
+		auto tilemapVertexSource = R"(
+#version 450 core
+
 layout(location = 0) in vec3 a_Position;
 layout(location = 1) in vec2 a_TexCoord;
 
-uniform mat4 u_ProjectionView;
-uniform mat4 u_Transform;
+layout(std140, binding = 0) uniform Camera
+{
+	mat4 u_ProjectionView;
+	mat4 u_Projection;
+	mat4 u_View;
+	mat4 u_SkyboxView;
+};
 
 out vec2 v_TexCoord;
 
 void main()
 {
 	v_TexCoord = a_TexCoord;
-	gl_Position = u_ProjectionView * u_Transform * vec4(a_Position, 1.0);
+	gl_Position = u_ProjectionView * vec4(a_Position, 1.0);
 }
 )";
 
-		auto fSource = R"(
-#version 330 core
+		auto tilemapFragmentSource = R"(
+#version 450 core
 
 layout(location = 0) out vec4 color;
 
 in vec2 v_TexCoord;
 
-uniform sampler2D u_Texture;
-uniform float u_TilingFactor;
-uniform vec4 u_Color;
+layout(binding = 0) uniform sampler2D u_Atlas;
 
 void main()
 {
-	color = u_Color * texture(u_Texture, v_TexCoord * u_TilingFactor);
+	color = texture(u_Atlas, v_TexCoord);
 }
 )";
 
-		s_TextureShader = Shader::Create("Texture", vSource, fSource);
-		s_TextureShader->Bind();
-		s_TextureShader->SetInt("u_Texture", 0);
+		s_Data.TilemapShader = Shader::Create("Tilemap", tilemapVertexSource, tilemapFragmentSource);
 	}
 
 	void Renderer2D::Shutdown()
 	{
+		HZ_PROFILE_FUNCTION();
+		s_Data.QuadVertexBufferBase = nullptr;
+		s_Data.QuadVertexBufferPtr = nullptr;
+		s_Data.QuadVertexBuffer = nullptr;
+		s_Data.QuadVertexArray = nullptr;
+		s_Data.TextureShader = nullptr;
+		s_Data.TilemapShader = nullptr;
+		s_Data.WhiteTexture = nullptr;
+
+		for (auto& slot : s_Data.TextureSlots)
+			slot = nullptr;
 	}
 
 	void Renderer2D::BeginScene(const OrthographicCamera& camera)
 	{
 		HZ_PROFILE_FUNCTION();
-		s_TextureShader->Bind();
-		s_TextureShader->SetMat4("u_ProjectionView", camera.GetProjectionViewMatrix());
-		s_QuadVertexArray->Bind();
+		const glm::mat4& view = camera.GetViewMatrix();
+		Renderer::SetCameraData({ camera.GetProjectionViewMatrix(), camera.GetProjectionMatrix(), view, glm::mat4(glm::mat3(view)) });
+
+		// the corners of clip space back in world space, the camera may be rotated
+		glm::mat4 inverse = glm::inverse(camera.GetProjectionViewMatrix());
+		s_Data.ViewMin = glm::vec2(FLT_MAX);
+		s_Data.ViewMax = glm::vec2(-FLT_MAX);
+		for (const glm::vec2& corner : s_QuadVertexPositions)
+		{
+			glm::vec2 world = glm::vec2(inverse * glm::vec4(corner * 2.0f, 0.0f, 1.0f));
+			s_Data.ViewMin = glm::min(s_Data.ViewMin, world);
+			s_Data.ViewMax = glm::max(s_Data.ViewMax, world);
+		}
+
+		StartBatch();
 	}
 
 	void Renderer2D::EndScene()
 	{
 		HZ_PROFILE_FUNCTION();
+		EndBatch();
+
+		s_Data.ViewMin = glm::vec2(-FLT_MAX);
+		s_Data.ViewMax = glm::vec2(FLT_MAX);
+	}
+
+	void Renderer2D::Flush()
+	{
+		HZ_PROFILE_FUNCTION();
+		if (s_Data.QuadIndexCount == 0)
+			return; // nothing to draw
+
+		// the shader and vertex array are bound again in case another renderer was used in between
+		s_Data.TextureShader->Bind();
+		for (uint32_t i = 0; i < s_Data.TextureSlotIndex; i++)
+			s_Data.TextureSlots[i]->Bind(i);
+		s_Data.QuadVertexArray->Bind();
+		RenderCommand::DrawIndexed(s_Data.QuadVertexArray, s_Data.QuadIndexCount, 0, s_Data.QuadBaseVertex);
+		s_Data.Stats.DrawCalls++;
 	}
 
 	void Renderer2D::DrawRotatedQuad(const glm::vec2& position, float rotation, const glm::vec4& color, const glm::vec2& size)
@@ -107,19 +401,12 @@ void main()
 	void Renderer2D::DrawRotatedQuad(const glm::vec3& position, float rotation, const glm::vec4& color, const glm::vec2& size)
 	{
 		HZ_PROFILE_FUNCTION();
-		s_WhiteTexture->Bind();
-
-		s_TextureShader->SetFloat4("u_Color", color);
-		s_TextureShader->SetFloat("u_TilingFactor", 1.0f);
-
-		// Translation * Rotation * Scale
-		glm::mat4 transform =
-			glm::translate(glm::mat4(1.0f), position) *
-			glm::rotate(glm::mat4(1.0f), rotation, glm::vec3(0.0f, 0.0f, 1.0f)) *
-			glm::scale(glm::mat4(1.0f), glm::vec3(size.x, size.y, 1.0f));
+		if (IsOutsideView(position, RotatedQuadExtent(size)))
+			return;
 
-		s_TextureShader->SetMat4("u_Transform", transform);
-		RenderCommand::DrawIndexed(s_QuadVertexArray);
+		glm::vec3 positions[4];
+		CalculateRotatedQuadPositions(position, rotation, size, positions);
+		SubmitQuad(positions, color, s_Data.WhiteTexture, 1.0f);
 	}
 
 	void Renderer2D::DrawRotatedQuad(const glm::vec2& position, float rotation, const Ref<Texture>& texture, const glm::vec2& size, const glm::vec4& tintColor, float tilingFactor)
@@ -130,19 +417,12 @@ void main()
 	void Renderer2D::DrawRotatedQuad(const glm::vec3& position, float rotation, const Ref<Texture>& texture, const glm::vec2& size, const glm::vec4& tintColor, float tilingFactor)
 	{
 		HZ_PROFILE_FUNCTION();
-		texture->Bind();
+		if (IsOutsideView(position, RotatedQuadExtent(size)))
+			return;
 
-		s_TextureShader->SetFloat4("u_Color", tintColor);
-		s_TextureShader->SetFloat("u_TilingFactor", tilingFactor);
-
-		// Translation * Rotation * Scale
-		glm::mat4 transform =
-			glm::translate(glm::mat4(1.0f), position) *
-			glm::rotate(glm::mat4(1.0f), rotation, glm::vec3(0.0f, 0.0f, 1.0f)) *
-			glm::scale(glm::mat4(1.0f), glm::vec3(size.x, size.y, 1.0f));
-
-		s_TextureShader->SetMat4("u_Transform", transform);
-		RenderCommand::DrawIndexed(s_QuadVertexArray);
+		glm::vec3 positions[4];
+		CalculateRotatedQuadPositions(position, rotation, size, positions);
+		SubmitQuad(positions, tintColor, texture, tilingFactor);
 	}
 
 	void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec4& color, const glm::vec2& size)
@@ -153,18 +433,12 @@ void main()
 	void Renderer2D::DrawQuad(const glm::vec3& position, const glm::vec4& color, const glm::vec2& size)
 	{
 		HZ_PROFILE_FUNCTION();
-		s_WhiteTexture->Bind();
-
-		s_TextureShader->SetFloat4("u_Color", color);
-		s_TextureShader->SetFloat("u_TilingFactor", 1.0f);
+		if (IsOutsideView(position, QuadExtent(size)))
+			return;
 
-		// Translation * Rotation * Scale
-		glm::mat4 transform = 
-			glm::translate(glm::mat4(1.0f), position) * 
-			glm::scale(glm::mat4(1.0f), glm::vec3(size.x, size.y, 1.0f));
-
-		s_TextureShader->SetMat4("u_Transform", transform);
-		RenderCommand::DrawIndexed(s_QuadVertexArray);
+		glm::vec3 positions[4];
+		CalculateQuadPositions(position, size, positions);
+		SubmitQuad(positions, color, s_Data.WhiteTexture, 1.0f);
 	}
 
 	void Renderer2D::DrawQuad(const glm::vec2& position, const Ref<Texture>& texture, const glm::vec2& size, const glm::vec4& tintColor, float tilingFactor)
@@ -175,18 +449,98 @@ void main()
 	void Renderer2D::DrawQuad(const glm::vec3& position, const Ref<Texture>& texture, const glm::vec2& size, const glm::vec4& tintColor, float tilingFactor)
 	{
 		HZ_PROFILE_FUNCTION();
-		texture->Bind();
+		if (IsOutsideView(position, QuadExtent(size)))
+			return;
+
+		glm::vec3 positions[4];
+		CalculateQuadPositions(position, size, positions);
+		SubmitQuad(positions, tintColor, texture, tilingFactor);
+	}
+
+	void Renderer2D::DrawQuad(const glm::vec2& position, const Ref<SubTexture2D>& subTexture, const glm::vec2& size, const glm::vec4& tintColor)
+	{
+		DrawQuad({ position.x, position.y, 0.0f }, subTexture, size, tintColor);
+	}
+
+	void Renderer2D::DrawQuad(const glm::vec3& position, const Ref<SubTexture2D>& subTexture, const glm::vec2& size, const glm::vec4& tintColor)
+	{
+		HZ_PROFILE_FUNCTION();
+		if (IsOutsideView(position, QuadExtent(size)))
+			return;
+
+		glm::vec3 positions[4];
+		CalculateQuadPositions(position, size, positions);
+		SubmitQuad(positions, tintColor, subTexture->GetTexture(), 1.0f, subTexture->GetTexCoords());
+	}
+
+	void Renderer2D::DrawRotatedQuad(const glm::vec2& position, float rotation, const Ref<SubTexture2D>& subTexture, const glm::vec2& size, const glm::vec4& tintColor)
+	{
+		DrawRotatedQuad({ position.x, position.y, 0.0f }, rotation, subTexture, size, tintColor);
+	}
+
+	void Renderer2D::DrawRotatedQuad(const glm::vec3& position, float rotation, const Ref<SubTexture2D>& subTexture, const glm::vec2& size, const glm::vec4& tintColor)
+	{
+		HZ_PROFILE_FUNCTION();
+		if (IsOutsideView(position, RotatedQuadExtent(size)))
+			return;
 
-		s_TextureShader->SetFloat4("u_Color", tintColor);
-		s_TextureShader->SetFloat("u_TilingFactor", tilingFactor);
+		glm::vec3 positions[4];
+		CalculateRotatedQuadPositions(position, rotation, size, positions);
+		SubmitQuad(positions, tintColor, subTexture->GetTexture(), 1.0f, subTexture->GetTexCoords());
+	}
 
-		// Translation * Rotation * Scale
-		glm::mat4 transform =
-			glm::translate(glm::mat4(1.0f), position) *
-			glm::scale(glm::mat4(1.0f), glm::vec3(size.x, size.y, 1.0f));
+	void Renderer2D::DrawTilemap(Tilemap& tilemap)
+	{
+		HZ_PROFILE_FUNCTION();
+		// the quads drawn so far go below the tilemap
+		if (s_Data.QuadIndexCount > 0)
+			NextBatch();
+
+		// the range of chunks the view touches, in float until it is clamped to the map
+		glm::vec2 chunkSize = tilemap.m_TileSize * (float)Tilemap::ChunkSize;
+		glm::vec2 first = glm::floor((s_Data.ViewMin - glm::vec2(tilemap.m_Position)) / chunkSize);
+		glm::vec2 last = glm::floor((s_Data.ViewMax - glm::vec2(tilemap.m_Position)) / chunkSize);
+		first = glm::max(first, glm::vec2(0.0f));
+		last = glm::min(last, glm::vec2((float)tilemap.m_ChunksX - 1.0f, (float)tilemap.m_ChunksY - 1.0f));
+		if (first.x > last.x || first.y > last.y)
+			return;
+
+		bool bound = false;
+		for (uint32_t chunkY = (uint32_t)first.y; chunkY <= (uint32_t)last.y; chunkY++)
+		{
+			for (uint32_t chunkX = (uint32_t)first.x; chunkX <= (uint32_t)last.x; chunkX++)
+			{
+				if (!tilemap.UpdateChunk(chunkX, chunkY))
+					continue;
+
+				const Tilemap::Chunk& chunk = tilemap.m_Chunks[(size_t)chunkY * tilemap.m_ChunksX + chunkX];
+				if (chunk.QuadCount == 0)
+					continue;
+
+				if (!bound)
+				{
+					s_Data.TilemapShader->Bind();
+					tilemap.m_Atlas->Bind(0);
+					bound = true;
+				}
+				chunk.ChunkVertexArray->Bind();
+				RenderCommand::DrawIndexed(chunk.ChunkVertexArray, chunk.QuadCount * 6);
+
+				s_Data.Stats.DrawCalls++;
+				s_Data.Stats.QuadCount += chunk.QuadCount;
+				s_Data.Stats.TilemapChunks++;
+			}
+		}
+	}
+
+	void Renderer2D::ResetStats()
+	{
+		s_Data.Stats = Statistics();
+	}
 
-		s_TextureShader->SetMat4("u_Transform", transform);
-		RenderCommand::DrawIndexed(s_QuadVertexArray);
+	Renderer2D::Statistics Renderer2D::GetStats()
+	{
+		return s_Data.Stats;
 	}
 
-}
\ No newline at end of file
+}
@@ -4,7 +4,9 @@
 #include "VertexArray.h"
 #include "Shader.h"
 #include "OrthographicCamera.h"
-#include <Hazel\Renderer\Texture.h>
+#include "Texture.h"
+#include "SubTexture2D.h"
+#include "Tilemap.h"
 
 namespace Hazel {
 
@@ -14,8 +16,10 @@ namespace Hazel {
 		static void Init();
 		static void Shutdown();
 
+		// Quads entirely outside what the camera sees are dropped until EndScene
 		static void BeginScene(const OrthographicCamera& camera);
 		static void EndScene();
+		static void Flush();
 
 		// Primitives
 		static void DrawQuad(const glm::vec2& position, const glm::vec4& color = { 1.0f, 1.0f, 1.0f, 1.0f }, const glm::vec2& size = { 1.0f, 1.0f });
@@ -28,11 +32,29 @@ namespace Hazel {
 		static void DrawRotatedQuad(const glm::vec2& position, float rotation, const Ref<Texture>& texture, const glm::vec2& size = { 1.0f, 1.0f }, const glm::vec4& tintColor = { 1.0f, 1.0f, 1.0f, 0.0f }, float tilingFactor = 1.0f);
 		static void DrawRotatedQuad(const glm::vec3& position, float rotation, const Ref<Texture>& texture, const glm::vec2& size = { 1.0f, 1.0f }, const glm::vec4& tintColor = { 1.0f, 1.0f, 1.0f, 0.0f }, float tilingFactor = 1.0f);
 
-
-	private:
-		static Ref<VertexArray> s_QuadVertexArray;
-		static Ref<Shader> s_TextureShader;
-		static Ref<Texture2D> s_WhiteTexture;
+		// sprites of an atlas page batch together like any quads sharing a texture
+		static void DrawQuad(const glm::vec2& position, const Ref<SubTexture2D>& subTexture, const glm::vec2& size = { 1.0f, 1.0f }, const glm::vec4& tintColor = { 1.0f, 1.0f, 1.0f, 1.0f });
+		static void DrawQuad(const glm::vec3& position, const Ref<SubTexture2D>& subTexture, const glm::vec2& size = { 1.0f, 1.0f }, const glm::vec4& tintColor = { 1.0f, 1.0f, 1.0f, 1.0f });
+		static void DrawRotatedQuad(const glm::vec2& position, float rotation, const Ref<SubTexture2D>& subTexture, const glm::vec2& size = { 1.0f, 1.0f }, const glm::vec4& tintColor = { 1.0f, 1.0f, 1.0f, 1.0f });
+		static void DrawRotatedQuad(const glm::vec3& position, float rotation, const Ref<SubTexture2D>& subTexture, const glm::vec2& size = { 1.0f, 1.0f }, const glm::vec4& tintColor = { 1.0f, 1.0f, 1.0f, 1.0f });
+
+		// Draws the chunks of the map the camera sees, rebuilding the ones whose tiles changed.
+		// Ends the current batch, quads drawn before end up below the map.
+		static void DrawTilemap(Tilemap& tilemap);
+
+		// Stats
+		struct Statistics
+		{
+			uint32_t DrawCalls = 0;
+			uint32_t QuadCount = 0;
+			uint32_t CulledQuads = 0; // outside the camera's view, never written to the batch
+			uint32_t TilemapChunks = 0;
+
+			uint32_t GetTotalVertexCount() const { return QuadCount * 4; }
+			uint32_t GetTotalIndexCount() const { return QuadCount * 6; }
+		};
+		static void ResetStats();
+		static Statistics GetStats();
 	};
 
 }
\ No newline at end of file
@@ -1,15 +1,40 @@
 #include "hzpch.h"
 #include "RendererAPI.h"
 
+#include "Platform/OpenGL/OpenGLRendererAPI.h"
+#include "Platform/Null/NullRendererAPI.h"
+
 namespace Hazel {
 
 	RendererAPI::API RendererAPI::s_API = RendererAPI::API::OpenGL;
+	RendererAPI::Counters RendererAPI::s_Counters;
+
+    Scope<RendererAPI> RendererAPI::Create()
+    {
+        switch (s_API)
+        {
+        case RendererAPI::API::None:
+            HZ_CORE_ASSERT(false, "RendererAPI::None is not supported!");
+            return nullptr;
+        case RendererAPI::API::OpenGL:
+            return CreateScope<OpenGLRendererAPI>();
+        case RendererAPI::API::Null:
+            return CreateScope<NullRendererAPI>();
+        }
+
+        HZ_CORE_ASSERT(false, "Unknown renderer API!");
+        return nullptr;
+    }
 
 	void RendererAPI::SetClearColor(const glm::vec4& color)
 	{
 	}
 
-	void RendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray)
+	void RendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t firstIndex, uint32_t baseVertex)
+	{
+	}
+
+	void RendererAPI::DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t instanceCount, uint32_t indexCount, uint32_t baseInstance)
 	{
 	}
 	
@@ -10,9 +10,22 @@ namespace Hazel {
 	public:
 		enum class API
 		{
-			None = 0, OpenGL = 1
+			None = 0, OpenGL = 1,
+			Null = 2 // headless, records what would have been drawn without a GPU
+		};
+
+		// Work submitted to the GPU since the last ResetCounters, bumped by the platform code
+		struct Counters
+		{
+			uint32_t DrawCalls = 0;
+			uint32_t Indices = 0; // drawn, once per instance
+			uint32_t StateChanges = 0; // shader, vertex array, texture and fixed function state
+			uint32_t UploadedBytes = 0; // buffer and texture data
+			uint32_t SkippedStateChanges = 0; // redundant ones the backend filtered out
 		};
 	public:
+		virtual ~RendererAPI() = default;
+
 		virtual void Init() = 0;
 		virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) = 0;
 		virtual void SetClearColor(const glm::vec4& color) = 0;
@@ -22,11 +35,23 @@ namespace Hazel {
 		virtual void SetDepthFuncLessThanOrEqualTo() = 0;
 		virtual void SetDepthFuncLessThan() = 0;
 
-		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray) = 0;
+		// baseVertex is added to every index, e.g. to draw from where a stream buffer was mapped
+		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0, uint32_t firstIndex = 0, uint32_t baseVertex = 0) = 0;
+		// per-instance attributes start at instance baseInstance of their buffer
+		virtual void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t instanceCount, uint32_t indexCount = 0, uint32_t baseInstance = 0) = 0;
+
+		virtual uint32_t GetMaxTextureSlots() = 0;
 
 		static inline API GetAPI() { return s_API; }
+		// has to be called before the Application creates its window
+		static inline void SetAPI(API api) { s_API = api; }
+		static Scope<RendererAPI> Create();
+
+		static inline Counters& GetCounters() { return s_Counters; }
+		static inline void ResetCounters() { s_Counters = Counters(); }
 	private:
 		static API s_API;
+		static Counters s_Counters;
 	};
 
 }
\ No newline at end of file
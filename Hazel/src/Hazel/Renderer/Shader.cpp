@@ -3,6 +3,7 @@
 
 #include "Renderer.h"
 #include "Platform/OpenGL/OpenGLShader.h"
+#include "Platform/Null/NullShader.h"
 
 namespace Hazel {
 
@@ -20,6 +21,8 @@ namespace Hazel {
             return nullptr;
         case RendererAPI::API::OpenGL:
             return std::make_shared<OpenGLShader>(filepath);
+        case RendererAPI::API::Null:
+            return std::make_shared<NullShader>(filepath);
         }
 
         HZ_CORE_ASSERT(false, "Unknown renderer API!");
@@ -35,6 +38,8 @@ namespace Hazel {
             return nullptr;
         case RendererAPI::API::OpenGL:
             return std::make_shared<OpenGLShader>(name, vertexSrc, fragmentSrc);
+        case RendererAPI::API::Null:
+            return std::make_shared<NullShader>(name, vertexSrc, fragmentSrc);
         }
 
         HZ_CORE_ASSERT(false, "Unknown renderer API!");
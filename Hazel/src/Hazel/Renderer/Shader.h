@@ -5,6 +5,9 @@
 
 namespace Hazel {
 
+	// Resolved uniform location, -1 if the uniform does not exist (setting it is then a no-op)
+	using UniformHandle = int32_t;
+
 	class Shader
 	{
 	public:
@@ -18,6 +21,17 @@ namespace Hazel {
 		virtual void SetFloat3(const std::string& name, const glm::vec3& value) = 0;
 		virtual void SetFloat(const std::string& name, float value) = 0;
 		virtual void SetInt(const std::string& name, int value) = 0;
+		virtual void SetIntArray(const std::string& name, int* values, uint32_t count) = 0;
+
+		// Handle based setters skip the name lookup, fetch the handle once and reuse it in hot loops
+		virtual UniformHandle GetUniformHandle(const std::string& name) const = 0;
+
+		virtual void SetMat4(UniformHandle handle, const glm::mat4& value) = 0;
+		virtual void SetFloat4(UniformHandle handle, const glm::vec4& value) = 0;
+		virtual void SetFloat3(UniformHandle handle, const glm::vec3& value) = 0;
+		virtual void SetFloat(UniformHandle handle, float value) = 0;
+		virtual void SetInt(UniformHandle handle, int value) = 0;
+		virtual void SetIntArray(UniformHandle handle, int* values, uint32_t count) = 0;
 
 		virtual const std::string& GetName() const = 0;
 
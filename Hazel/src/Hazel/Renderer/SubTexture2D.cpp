@@ -0,0 +1,24 @@
+#include "hzpch.h"
+#include "SubTexture2D.h"
+
+namespace Hazel {
+
+	SubTexture2D::SubTexture2D(const Ref<Texture2D>& texture, const glm::vec2& min, const glm::vec2& max)
+		: m_Texture(texture)
+	{
+		m_TexCoords[0] = { min.x, min.y };
+		m_TexCoords[1] = { max.x, min.y };
+		m_TexCoords[2] = { max.x, max.y };
+		m_TexCoords[3] = { min.x, max.y };
+	}
+
+	Ref<SubTexture2D> SubTexture2D::CreateFromCoords(const Ref<Texture2D>& texture, const glm::vec2& coords, const glm::vec2& cellSize, const glm::vec2& spriteSize)
+	{
+		HZ_CORE_ASSERT(texture->IsLoaded(), "Texture size is not known before it loaded!");
+		glm::vec2 textureSize = { (float)texture->GetWidth(), (float)texture->GetHeight() };
+		glm::vec2 min = coords * cellSize / textureSize;
+		glm::vec2 max = (coords + spriteSize) * cellSize / textureSize;
+		return CreateRef<SubTexture2D>(texture, min, max);
+	}
+
+}
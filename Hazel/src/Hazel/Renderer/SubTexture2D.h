@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Texture.h"
+
+#include <glm/glm.hpp>
+
+namespace Hazel {
+
+	// A rectangle of a texture drawn as a whole quad, e.g. a sprite on an atlas page
+	class SubTexture2D
+	{
+	public:
+		// min and max in texture coordinates
+		SubTexture2D(const Ref<Texture2D>& texture, const glm::vec2& min, const glm::vec2& max);
+
+		const Ref<Texture2D>& GetTexture() const { return m_Texture; }
+		// bottom left, bottom right, top right, top left, in the order of the quad vertices
+		const glm::vec2* GetTexCoords() const { return m_TexCoords.data(); }
+
+		// A cell of a sprite sheet laid out in a grid of cellSize pixels, counted from the bottom left.
+		// The size of the texture has to be known, an asynchronously created one must have loaded.
+		static Ref<SubTexture2D> CreateFromCoords(const Ref<Texture2D>& texture, const glm::vec2& coords, const glm::vec2& cellSize, const glm::vec2& spriteSize = { 1.0f, 1.0f });
+	private:
+		Ref<Texture2D> m_Texture;
+		std::array<glm::vec2, 4> m_TexCoords;
+	};
+
+}
@@ -1,8 +1,10 @@
 #include "hzpch.h"
 #include "Texture.h"
 #include "Renderer.h"
+#include "TextureLoader.h"
 
 #include "Platform/OpenGL/OpenGLTexture.h"
+#include "Platform/Null/NullTexture.h"
 
 
 namespace Hazel {
@@ -16,6 +18,8 @@ namespace Hazel {
             return nullptr;
         case RendererAPI::API::OpenGL:
             return CreateRef<OpenGLTexture2D>(width, height);
+        case RendererAPI::API::Null:
+            return CreateRef<NullTexture2D>(width, height);
         }
 
         HZ_CORE_ASSERT(false, "Unknown renderer API!");
@@ -31,12 +35,28 @@ namespace Hazel {
             return nullptr;
         case RendererAPI::API::OpenGL:
             return CreateRef<OpenGLTexture2D>(path);
+        case RendererAPI::API::Null:
+            return CreateRef<NullTexture2D>(path);
         }
 
         HZ_CORE_ASSERT(false, "Unknown renderer API!");
         return nullptr;
 	}
 
+	Ref<Texture2D> Texture2D::CreateAsync(const std::string& path, const LoadedCallbackFn& callback)
+	{
+		HZ_PROFILE_FUNCTION();
+		Ref<Texture2D> texture = Create(1, 1);
+		if (!texture)
+			return nullptr;
+
+		uint32_t whiteTextureData = 0xffffffff;
+		texture->SetData(&whiteTextureData, sizeof(uint32_t));
+
+		TextureLoader::Load(texture, path, callback);
+		return texture;
+	}
+
     Ref<TextureCubeMap> TextureCubeMap::Create(const std::vector<std::string>& filepaths)
     {
         switch (Renderer::GetAPI())
@@ -46,6 +66,8 @@ namespace Hazel {
             return nullptr;
         case RendererAPI::API::OpenGL:
             return CreateRef<OpenGLTextureCubeMap>(filepaths);
+        case RendererAPI::API::Null:
+            return CreateRef<NullTextureCubeMap>(filepaths);
         }
 
         HZ_CORE_ASSERT(false, "Unknown renderer API!");
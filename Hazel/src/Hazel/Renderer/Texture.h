@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <string>
 
 namespace Hazel {
@@ -11,6 +12,7 @@ namespace Hazel {
 
 		virtual uint32_t GetWidth() const = 0;
 		virtual uint32_t GetHeight() const = 0;
+		virtual uint32_t GetRendererID() const = 0;
 
 		virtual void SetData(void* data, uint32_t size) = 0;
 		
@@ -20,8 +22,25 @@ namespace Hazel {
 	class Texture2D : public Texture
 	{
 	public:
+		using LoadedCallbackFn = std::function<void(const Ref<Texture2D>&)>;
+
+		// false while an asynchronously created texture still holds its placeholder
+		bool IsLoaded() const { return m_Loaded; }
+
 		static Ref<Texture2D> Create(uint32_t width, uint32_t height);
 		static Ref<Texture2D> Create(const std::string& path);
+
+		// Returns a 1x1 white placeholder right away, the image is decoded on a worker thread
+		// and swapped in on the main thread by TextureLoader::ProcessUploads, after which
+		// the callback runs. Width, height and renderer ID change at that point.
+		static Ref<Texture2D> CreateAsync(const std::string& path, const LoadedCallbackFn& callback = nullptr);
+	protected:
+		// replaces the whole image with 8 bit per channel pixels, channels is 3 or 4
+		virtual void SetImage(uint32_t width, uint32_t height, uint32_t channels, const void* pixels) = 0;
+	protected:
+		bool m_Loaded = true;
+
+		friend class TextureLoader;
 	};
 
 	class TextureCubeMap : public Texture
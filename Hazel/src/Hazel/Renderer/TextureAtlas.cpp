@@ -0,0 +1,348 @@
+#include "hzpch.h"
+#include "TextureAtlas.h"
+
+#include "stb_image.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace Hazel {
+
+	/////////////////////////////////////////////////////////////////
+	/// SkylinePacker ///////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////
+
+	SkylinePacker::SkylinePacker(uint32_t width, uint32_t height)
+		: m_Width(width), m_Height(height)
+	{
+		m_Skyline.push_back({ 0, 0, width });
+	}
+
+	uint32_t SkylinePacker::Fit(size_t node, uint32_t width, uint32_t height) const
+	{
+		if (m_Skyline[node].X + width > m_Width)
+			return UINT32_MAX;
+
+		// the rectangle rests on the highest node it spans
+		uint32_t y = 0;
+		uint32_t remaining = width;
+		for (size_t i = node; remaining > 0; i++)
+		{
+			y = std::max(y, m_Skyline[i].Y);
+			if (y + height > m_Height)
+				return UINT32_MAX;
+			remaining -= std::min(remaining, m_Skyline[i].Width);
+		}
+		return y;
+	}
+
+	bool SkylinePacker::Pack(uint32_t width, uint32_t height, glm::uvec2& position)
+	{
+		HZ_CORE_ASSERT(width > 0 && height > 0, "Cannot pack an empty rectangle!");
+		size_t best = SIZE_MAX;
+		uint32_t bestTop = UINT32_MAX, bestWidth = UINT32_MAX;
+		for (size_t i = 0; i < m_Skyline.size(); i++)
+		{
+			uint32_t y = Fit(i, width, height);
+			if (y == UINT32_MAX)
+				continue;
+
+			// lowest top edge first, the narrower ledge on ties
+			if (y + height < bestTop || (y + height == bestTop && m_Skyline[i].Width < bestWidth))
+			{
+				best = i;
+				bestTop = y + height;
+				bestWidth = m_Skyline[i].Width;
+				position = { m_Skyline[i].X, y };
+			}
+		}
+
+		if (best == SIZE_MAX)
+			return false;
+
+		Node node = { position.x, bestTop, width };
+		m_Skyline.insert(m_Skyline.begin() + best, node);
+
+		// the nodes now covered by the new one shrink or go away
+		uint32_t end = node.X + node.Width;
+		for (size_t i = best + 1; i < m_Skyline.size(); )
+		{
+			Node& next = m_Skyline[i];
+			if (next.X >= end)
+				break;
+
+			uint32_t covered = end - next.X;
+			if (covered < next.Width)
+			{
+				next.X += covered;
+				next.Width -= covered;
+				break;
+			}
+			m_Skyline.erase(m_Skyline.begin() + i);
+		}
+
+		// neighbours at the same height are one ledge
+		for (size_t i = 0; i + 1 < m_Skyline.size(); )
+		{
+			if (m_Skyline[i].Y == m_Skyline[i + 1].Y)
+			{
+				m_Skyline[i].Width += m_Skyline[i + 1].Width;
+				m_Skyline.erase(m_Skyline.begin() + i + 1);
+			}
+			else
+				i++;
+		}
+		return true;
+	}
+
+	/////////////////////////////////////////////////////////////////
+	/// TextureAtlas ////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////
+
+	// uncompressed 32 bit TGA, rows from the bottom which is the default origin of the format
+	static bool WriteTGA(const std::string& path, uint32_t width, uint32_t height, const uint8_t* pixels)
+	{
+		std::ofstream out(path, std::ios::out | std::ios::binary);
+		if (!out)
+		{
+			HZ_CORE_ERROR("Could not write atlas page '{0}'", path);
+			return false;
+		}
+
+		uint8_t header[18] = {};
+		header[2] = 2; // uncompressed true color
+		header[12] = width & 0xff;
+		header[13] = (width >> 8) & 0xff;
+		header[14] = height & 0xff;
+		header[15] = (height >> 8) & 0xff;
+		header[16] = 32; // bits per pixel
+		header[17] = 8;  // alpha bits
+		out.write((const char*)header, sizeof(header));
+
+		// TGA stores BGRA
+		std::vector<uint8_t> bgra(pixels, pixels + (size_t)width * height * 4);
+		for (size_t i = 0; i < bgra.size(); i += 4)
+			std::swap(bgra[i], bgra[i + 2]);
+		out.write((const char*)bgra.data(), bgra.size());
+		return (bool)out;
+	}
+
+	TextureAtlas::TextureAtlas(uint32_t pageSize, uint32_t padding)
+		: m_PageSize(pageSize), m_Padding(padding)
+	{
+		HZ_CORE_ASSERT(pageSize > 0 && pageSize <= UINT16_MAX, "Atlas pages have to be saved as TGA, at most 65535 pixels wide!");
+	}
+
+	bool TextureAtlas::AddImage(const std::string& name, const std::string& path)
+	{
+		HZ_PROFILE_FUNCTION();
+		int width, height, channels;
+		stbi_set_flip_vertically_on_load_thread(true);
+		stbi_uc* pixels = stbi_load(path.c_str(), &width, &height, &channels, 4);
+		if (!pixels)
+		{
+			HZ_CORE_ERROR("Failed to load atlas image '{0}': {1}", path, stbi_failure_reason());
+			return false;
+		}
+
+		AddImage(name, width, height, pixels);
+		stbi_image_free(pixels);
+		return true;
+	}
+
+	void TextureAtlas::AddImage(const std::string& name, uint32_t width, uint32_t height, const void* pixels)
+	{
+		const uint8_t* bytes = (const uint8_t*)pixels;
+		m_PendingImages.push_back({ name, width, height, std::vector<uint8_t>(bytes, bytes + (size_t)width * height * 4) });
+	}
+
+	void TextureAtlas::Build()
+	{
+		HZ_PROFILE_FUNCTION();
+		// tall images first, the short ones fill the ledges they leave
+		std::stable_sort(m_PendingImages.begin(), m_PendingImages.end(), [](const Image& a, const Image& b)
+		{
+			return a.Height != b.Height ? a.Height > b.Height : a.Width > b.Width;
+		});
+
+		for (const Image& image : m_PendingImages)
+		{
+			if (image.Width == 0 || image.Height == 0 || image.Width + m_Padding > m_PageSize || image.Height + m_Padding > m_PageSize)
+			{
+				HZ_CORE_ERROR("Image '{0}' ({1}x{2}) does not fit on a {3}x{3} atlas page", image.Name, image.Width, image.Height, m_PageSize);
+				continue;
+			}
+
+			if (PackImage(image))
+				continue;
+
+			// an empty page always has room for an image that fits on a page at all
+			AddPage();
+			PackImage(image);
+		}
+		m_PendingImages.clear();
+
+		for (Page& page : m_Pages)
+		{
+			if (!page.Dirty)
+				continue;
+
+			page.Texture->SetData(page.Pixels.data(), (uint32_t)page.Pixels.size());
+			page.Dirty = false;
+		}
+	}
+
+	Ref<SubTexture2D> TextureAtlas::Get(const std::string& name) const
+	{
+		auto it = m_Sprites.find(name);
+		return it != m_Sprites.end() ? it->second.SubTexture : nullptr;
+	}
+
+	bool TextureAtlas::Save(const std::string& path) const
+	{
+		HZ_PROFILE_FUNCTION();
+		for (const Page& page : m_Pages)
+		{
+			if (page.Pixels.empty())
+			{
+				HZ_CORE_ERROR("Cannot save texture atlas '{0}', some of its pages were loaded from a file", path);
+				return false;
+			}
+		}
+
+		std::ofstream out(path, std::ios::out);
+		if (!out)
+		{
+			HZ_CORE_ERROR("Could not write texture atlas '{0}'", path);
+			return false;
+		}
+
+		// the pages sit next to the index, which refers to them by file name only
+		std::filesystem::path indexPath(path);
+		out << "HazelAtlas 1\n";
+		for (size_t index = 0; index < m_Pages.size(); index++)
+		{
+			const Page& page = m_Pages[index];
+			std::string fileName = indexPath.stem().string() + "_" + std::to_string(index) + ".tga";
+			if (!WriteTGA((indexPath.parent_path() / fileName).string(), page.Width, page.Height, page.Pixels.data()))
+				return false;
+
+			out << "page " << page.Width << " " << page.Height << " " << fileName << "\n";
+		}
+
+		for (const auto& [name, sprite] : m_Sprites)
+			out << "sprite " << sprite.Page << " " << sprite.X << " " << sprite.Y << " " << sprite.Width << " " << sprite.Height << " " << name << "\n";
+
+		return (bool)out;
+	}
+
+	Ref<TextureAtlas> TextureAtlas::Load(const std::string& path)
+	{
+		HZ_PROFILE_FUNCTION();
+		std::ifstream in(path, std::ios::in);
+		if (!in)
+		{
+			HZ_CORE_ERROR("Could not open texture atlas '{0}'", path);
+			return nullptr;
+		}
+
+		std::string magic;
+		uint32_t version = 0;
+		in >> magic >> version;
+		if (magic != "HazelAtlas" || version != 1)
+		{
+			HZ_CORE_ERROR("'{0}' is not a texture atlas, or one of an unsupported version", path);
+			return nullptr;
+		}
+
+		Ref<TextureAtlas> atlas = CreateRef<TextureAtlas>();
+		std::filesystem::path directory = std::filesystem::path(path).parent_path();
+		std::string type;
+		while (in >> type)
+		{
+			if (type == "page")
+			{
+				Page page;
+				std::string fileName;
+				in >> page.Width >> page.Height;
+				std::getline(in >> std::ws, fileName);
+				if (!in)
+				{
+					HZ_CORE_ERROR("Texture atlas '{0}' is malformed", path);
+					return nullptr;
+				}
+
+				page.Texture = Texture2D::CreateAsync((directory / fileName).string());
+				atlas->m_Pages.push_back(std::move(page));
+			}
+			else if (type == "sprite")
+			{
+				uint32_t page = 0, x = 0, y = 0, width = 0, height = 0;
+				std::string name;
+				in >> page >> x >> y >> width >> height;
+				std::getline(in >> std::ws, name);
+				if (!in)
+				{
+					HZ_CORE_ERROR("Texture atlas '{0}' is malformed", path);
+					return nullptr;
+				}
+
+				if (page >= atlas->m_Pages.size())
+				{
+					HZ_CORE_ERROR("Sprite '{0}' of texture atlas '{1}' is on a page that does not exist", name, path);
+					return nullptr;
+				}
+				atlas->AddSprite(name, page, x, y, width, height);
+			}
+			else
+			{
+				HZ_CORE_ERROR("Unknown entry '{0}' in texture atlas '{1}'", type, path);
+				return nullptr;
+			}
+		}
+
+		return atlas;
+	}
+
+	void TextureAtlas::AddSprite(const std::string& name, uint32_t page, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		glm::vec2 pageSize = { (float)m_Pages[page].Width, (float)m_Pages[page].Height };
+		glm::vec2 min = glm::vec2((float)x, (float)y) / pageSize;
+		glm::vec2 max = glm::vec2((float)(x + width), (float)(y + height)) / pageSize;
+		m_Sprites[name] = { page, x, y, width, height, CreateRef<SubTexture2D>(m_Pages[page].Texture, min, max) };
+	}
+
+	bool TextureAtlas::PackImage(const Image& image)
+	{
+		for (uint32_t index = 0; index < (uint32_t)m_Pages.size(); index++)
+		{
+			Page& page = m_Pages[index];
+			glm::uvec2 position;
+			if (!page.Packer || !page.Packer->Pack(image.Width + m_Padding, image.Height + m_Padding, position))
+				continue;
+
+			for (uint32_t row = 0; row < image.Height; row++)
+			{
+				memcpy(&page.Pixels[((size_t)(position.y + row) * page.Width + position.x) * 4],
+					&image.Pixels[(size_t)row * image.Width * 4], (size_t)image.Width * 4);
+			}
+			page.Dirty = true;
+
+			AddSprite(image.Name, index, position.x, position.y, image.Width, image.Height);
+			return true;
+		}
+		return false;
+	}
+
+	void TextureAtlas::AddPage()
+	{
+		Page page;
+		page.Width = m_PageSize;
+		page.Height = m_PageSize;
+		page.Texture = Texture2D::Create(m_PageSize, m_PageSize);
+		page.Packer = CreateScope<SkylinePacker>(m_PageSize, m_PageSize);
+		page.Pixels.resize((size_t)m_PageSize * m_PageSize * 4, 0);
+		m_Pages.push_back(std::move(page));
+	}
+
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "SubTexture2D.h"
+
+#include <glm/glm.hpp>
+
+#include <map>
+
+namespace Hazel {
+
+	// Packs rectangles into a fixed size area with the skyline bottom-left heuristic: every
+	// rectangle goes where its top edge ends up lowest, which wastes little space on sprites.
+	class SkylinePacker
+	{
+	public:
+		SkylinePacker(uint32_t width, uint32_t height);
+
+		// false when the rectangle does not fit anymore
+		bool Pack(uint32_t width, uint32_t height, glm::uvec2& position);
+
+		uint32_t GetWidth() const { return m_Width; }
+		uint32_t GetHeight() const { return m_Height; }
+	private:
+		struct Node
+		{
+			uint32_t X, Y, Width;
+		};
+
+		// the top of the skyline under [node x, node x + width), UINT32_MAX if it runs out of the area
+		uint32_t Fit(size_t node, uint32_t width, uint32_t height) const;
+	private:
+		uint32_t m_Width, m_Height;
+		std::vector<Node> m_Skyline; // left to right, covering the whole width
+	};
+
+	// Many images packed into a few pages of one texture each, so the sprites on a page batch
+	// together in Renderer2D. Images are added, packed and uploaded by Build, and looked up
+	// by name as SubTexture2D afterwards.
+	//
+	// Save writes a text index next to one TGA per page, Load reads it back decoding every page
+	// once. Index format, one entry per line:
+	//   HazelAtlas 1
+	//   page <width> <height> <file>
+	//   sprite <page> <x> <y> <width> <height> <name>
+	// Sprite rectangles are in pixels from the bottom left of their page.
+	class TextureAtlas
+	{
+	public:
+		// padding is left empty right of and above every image
+		TextureAtlas(uint32_t pageSize = 2048, uint32_t padding = 1);
+
+		// false if the image cannot be decoded
+		bool AddImage(const std::string& name, const std::string& path);
+		// 8 bit RGBA pixels, rows from the bottom like Texture2D::SetData
+		void AddImage(const std::string& name, uint32_t width, uint32_t height, const void* pixels);
+
+		// Packs the images added since the last build, largest first, onto the existing pages
+		// when they still have room or new ones otherwise, and uploads the pages that changed
+		void Build();
+
+		// nullptr for unknown names and images that were not built yet
+		Ref<SubTexture2D> Get(const std::string& name) const;
+
+		uint32_t GetPageCount() const { return (uint32_t)m_Pages.size(); }
+		const Ref<Texture2D>& GetPage(uint32_t index) const { return m_Pages[index].Texture; }
+
+		// pages loaded from a file cannot be saved again, they only exist on the GPU
+		bool Save(const std::string& path) const;
+		// pages are decoded in the background, see Texture2D::CreateAsync
+		static Ref<TextureAtlas> Load(const std::string& path);
+	private:
+		struct Image
+		{
+			std::string Name;
+			uint32_t Width, Height;
+			std::vector<uint8_t> Pixels;
+		};
+
+		struct Sprite
+		{
+			uint32_t Page;
+			uint32_t X, Y, Width, Height;
+			Ref<SubTexture2D> SubTexture;
+		};
+
+		struct Page
+		{
+			Ref<Texture2D> Texture;
+			uint32_t Width = 0, Height = 0;
+			Scope<SkylinePacker> Packer; // none for pages loaded from a file
+			std::vector<uint8_t> Pixels; // RGBA, rows from the bottom, empty for pages loaded from a file
+			bool Dirty = false;
+		};
+
+		void AddSprite(const std::string& name, uint32_t page, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+		bool PackImage(const Image& image);
+		void AddPage();
+	private:
+		uint32_t m_PageSize;
+		uint32_t m_Padding;
+
+		std::vector<Image> m_PendingImages;
+		std::vector<Page> m_Pages;
+		std::map<std::string, Sprite> m_Sprites; // ordered, saved files do not change between runs
+	};
+
+}
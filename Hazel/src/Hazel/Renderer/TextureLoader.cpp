@@ -0,0 +1,131 @@
+#include "hzpch.h"
+#include "TextureLoader.h"
+
+#include "Hazel/Core/JobSystem.h"
+#include "Hazel/Core/Timer.h"
+
+#include "stb_image.h"
+
+namespace Hazel {
+
+	struct DecodedImage
+	{
+		uint32_t ID;
+		int Width, Height, Channels;
+		stbi_uc* Pixels;
+		const char* FailureReason; // stb keeps it per thread, grab it on the worker
+	};
+
+	// only touched on the main thread, so textures are never released by a worker
+	struct PendingLoad
+	{
+		Ref<Texture2D> Texture;
+		std::string Path;
+		Texture2D::LoadedCallbackFn Callback;
+	};
+
+	struct TextureLoaderData
+	{
+		JobCounter Decoding;
+
+		std::mutex DecodedMutex;
+		std::vector<DecodedImage> Decoded;
+
+		std::unordered_map<uint32_t, PendingLoad> Pending;
+		uint32_t NextID = 1;
+	};
+
+	static TextureLoaderData s_Data;
+
+	void TextureLoader::Shutdown()
+	{
+		HZ_PROFILE_FUNCTION();
+		// in-flight decodes finish and land in Decoded
+		JobSystem::Wait(s_Data.Decoding);
+
+		for (DecodedImage& image : s_Data.Decoded)
+			stbi_image_free(image.Pixels);
+		s_Data.Decoded.clear();
+		s_Data.Pending.clear();
+	}
+
+	void TextureLoader::Load(const Ref<Texture2D>& texture, const std::string& path, const Texture2D::LoadedCallbackFn& callback)
+	{
+		HZ_PROFILE_FUNCTION();
+		uint32_t id = s_Data.NextID++;
+		texture->m_Loaded = false;
+		s_Data.Pending[id] = { texture, path, callback };
+
+		JobSystem::Run([id, path]()
+		{
+			HZ_PROFILE_SCOPE("TextureLoader decode");
+			DecodedImage image = { id, 0, 0, 0, nullptr, nullptr };
+			stbi_set_flip_vertically_on_load_thread(true);
+			image.Pixels = stbi_load(path.c_str(), &image.Width, &image.Height, &image.Channels, 0);
+			if (!image.Pixels)
+				image.FailureReason = stbi_failure_reason();
+
+			std::lock_guard<std::mutex> lock(s_Data.DecodedMutex);
+			s_Data.Decoded.push_back(image);
+		}, &s_Data.Decoding);
+	}
+
+	void TextureLoader::ProcessUploads(float budgetMillis)
+	{
+		HZ_PROFILE_FUNCTION();
+		if (s_Data.Pending.empty())
+			return;
+
+		std::vector<DecodedImage> decoded;
+		{
+			std::lock_guard<std::mutex> lock(s_Data.DecodedMutex);
+			decoded.swap(s_Data.Decoded);
+		}
+
+		Timer timer;
+		size_t i = 0;
+		for (; i < decoded.size(); i++)
+		{
+			if (i > 0 && timer.ElapsedMillis() >= budgetMillis)
+				break;
+
+			DecodedImage& image = decoded[i];
+			auto it = s_Data.Pending.find(image.ID);
+			HZ_CORE_ASSERT(it != s_Data.Pending.end(), "Decoded an image nobody asked for!");
+			PendingLoad load = std::move(it->second);
+			s_Data.Pending.erase(it);
+
+			if (!image.Pixels)
+			{
+				HZ_CORE_ERROR("Failed to load image '{0}': {1}", load.Path, image.FailureReason);
+				continue;
+			}
+			if (image.Channels != 3 && image.Channels != 4)
+			{
+				HZ_CORE_ERROR("Failed to load image '{0}': {1} channels are not supported", load.Path, image.Channels);
+				stbi_image_free(image.Pixels);
+				continue;
+			}
+
+			load.Texture->SetImage(image.Width, image.Height, image.Channels, image.Pixels);
+			load.Texture->m_Loaded = true;
+			stbi_image_free(image.Pixels);
+
+			if (load.Callback)
+				load.Callback(load.Texture);
+		}
+
+		// over budget, put the rest back in front of whatever finished meanwhile
+		if (i < decoded.size())
+		{
+			std::lock_guard<std::mutex> lock(s_Data.DecodedMutex);
+			s_Data.Decoded.insert(s_Data.Decoded.begin(), decoded.begin() + i, decoded.end());
+		}
+	}
+
+	uint32_t TextureLoader::GetPendingCount()
+	{
+		return (uint32_t)s_Data.Pending.size();
+	}
+
+}
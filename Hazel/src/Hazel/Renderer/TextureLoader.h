@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Hazel/Core/Core.h"
+#include "Texture.h"
+
+namespace Hazel {
+
+	// Decodes images on the JobSystem and uploads them on the main thread,
+	// see Texture2D::CreateAsync
+	class TextureLoader
+	{
+	public:
+		// waits for decodes in flight
+		static void Shutdown();
+
+		static void Load(const Ref<Texture2D>& texture, const std::string& path, const Texture2D::LoadedCallbackFn& callback = nullptr);
+
+		// Uploads decoded images until the budget is spent, at least one per call.
+		// Called once per frame by the Application, must run on the thread owning the context.
+		static void ProcessUploads(float budgetMillis = 2.0f);
+
+		static uint32_t GetPendingCount();
+	};
+
+}
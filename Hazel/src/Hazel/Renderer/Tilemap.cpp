@@ -0,0 +1,139 @@
+#include "hzpch.h"
+#include "Tilemap.h"
+
+namespace Hazel {
+
+	Tilemap::Tilemap(uint32_t width, uint32_t height, const Ref<Texture2D>& atlas, const glm::uvec2& tilePixels,
+		const glm::vec3& position, const glm::vec2& tileSize)
+		: m_Width(width), m_Height(height), m_Atlas(atlas), m_TilePixels(tilePixels), m_Position(position), m_TileSize(tileSize)
+	{
+		HZ_PROFILE_FUNCTION();
+		HZ_CORE_ASSERT(tilePixels.x > 0 && tilePixels.y > 0, "Tiles cannot be empty!");
+
+		m_ChunksX = (width + ChunkSize - 1) / ChunkSize;
+		m_ChunksY = (height + ChunkSize - 1) / ChunkSize;
+		m_Tiles.resize((size_t)width * height, EmptyTile);
+		m_Chunks.resize((size_t)m_ChunksX * m_ChunksY);
+
+		// enough quads for a full chunk, a chunk only draws as many as it has tiles
+		constexpr uint32_t maxIndices = ChunkSize * ChunkSize * 6;
+		std::vector<uint32_t> indices(maxIndices);
+		uint32_t offset = 0;
+		for (uint32_t i = 0; i < maxIndices; i += 6)
+		{
+			indices[i + 0] = offset + 0;
+			indices[i + 1] = offset + 1;
+			indices[i + 2] = offset + 2;
+
+			indices[i + 3] = offset + 2;
+			indices[i + 4] = offset + 3;
+			indices[i + 5] = offset + 0;
+
+			offset += 4;
+		}
+		m_IndexBuffer = IndexBuffer::Create(indices.data(), maxIndices);
+	}
+
+	uint32_t Tilemap::GetTile(uint32_t x, uint32_t y) const
+	{
+		HZ_CORE_ASSERT(x < m_Width && y < m_Height, "Tile is outside the map!");
+		return m_Tiles[(size_t)y * m_Width + x];
+	}
+
+	void Tilemap::SetTile(uint32_t x, uint32_t y, uint32_t tile)
+	{
+		HZ_CORE_ASSERT(x < m_Width && y < m_Height, "Tile is outside the map!");
+		uint32_t& current = m_Tiles[(size_t)y * m_Width + x];
+		if (current == tile)
+			return;
+
+		current = tile;
+		m_Chunks[(size_t)(y / ChunkSize) * m_ChunksX + x / ChunkSize].Dirty = true;
+	}
+
+	void Tilemap::SetTiles(const std::vector<uint32_t>& tiles)
+	{
+		HZ_CORE_ASSERT(tiles.size() == m_Tiles.size(), "Expected one tile per cell of the map!");
+		m_Tiles = tiles;
+		MarkAllDirty();
+	}
+
+	void Tilemap::SetPosition(const glm::vec3& position)
+	{
+		m_Position = position;
+		MarkAllDirty();
+	}
+
+	void Tilemap::MarkAllDirty()
+	{
+		for (Chunk& chunk : m_Chunks)
+			chunk.Dirty = true;
+	}
+
+	bool Tilemap::UpdateChunk(uint32_t chunkX, uint32_t chunkY)
+	{
+		Chunk& chunk = m_Chunks[(size_t)chunkY * m_ChunksX + chunkX];
+		if (!chunk.Dirty)
+			return true;
+		if (!m_Atlas->IsLoaded())
+			return false; // the tile coordinates depend on the size of the real image
+
+		HZ_PROFILE_FUNCTION();
+		uint32_t columns = std::max(m_Atlas->GetWidth() / m_TilePixels.x, 1u);
+		glm::vec2 tileUV = glm::vec2(m_TilePixels) / glm::vec2((float)m_Atlas->GetWidth(), (float)m_Atlas->GetHeight());
+
+		uint32_t endX = std::min((chunkX + 1) * ChunkSize, m_Width);
+		uint32_t endY = std::min((chunkY + 1) * ChunkSize, m_Height);
+
+		m_Vertices.clear();
+		chunk.QuadCount = 0;
+		for (uint32_t y = chunkY * ChunkSize; y < endY; y++)
+		{
+			for (uint32_t x = chunkX * ChunkSize; x < endX; x++)
+			{
+				uint32_t tile = m_Tiles[(size_t)y * m_Width + x];
+				if (tile == EmptyTile)
+					continue;
+
+				// the image is flipped on load, its top row ends up at v = 1
+				glm::vec2 uvMin = glm::vec2((float)(tile % columns), 0.0f) * tileUV;
+				uvMin.y = 1.0f - (tile / columns + 1) * tileUV.y;
+				glm::vec2 uvMax = uvMin + tileUV;
+
+				glm::vec3 min = m_Position + glm::vec3(x * m_TileSize.x, y * m_TileSize.y, 0.0f);
+				glm::vec3 max = min + glm::vec3(m_TileSize, 0.0f);
+				const TileVertex quad[4] = {
+					{ { min.x, min.y, min.z }, { uvMin.x, uvMin.y } },
+					{ { max.x, min.y, min.z }, { uvMax.x, uvMin.y } },
+					{ { max.x, max.y, min.z }, { uvMax.x, uvMax.y } },
+					{ { min.x, max.y, min.z }, { uvMin.x, uvMax.y } },
+				};
+				m_Vertices.insert(m_Vertices.end(), std::begin(quad), std::end(quad));
+				chunk.QuadCount++;
+			}
+		}
+		chunk.Dirty = false;
+
+		uint32_t size = (uint32_t)(m_Vertices.size() * sizeof(TileVertex));
+		if (size == 0)
+			return true;
+
+		if (size <= chunk.Capacity)
+		{
+			chunk.ChunkVertexBuffer->SetData(m_Vertices.data(), size);
+			return true;
+		}
+
+		chunk.ChunkVertexBuffer = VertexBuffer::Create((float*)m_Vertices.data(), size);
+		chunk.ChunkVertexBuffer->SetLayout({
+			{ ShaderDataType::Float3, "a_Position" },
+			{ ShaderDataType::Float2, "a_TexCoord" },
+			});
+		chunk.ChunkVertexArray = VertexArray::Create();
+		chunk.ChunkVertexArray->AddVertexBuffer(chunk.ChunkVertexBuffer);
+		chunk.ChunkVertexArray->SetIndexBuffer(m_IndexBuffer);
+		chunk.Capacity = size;
+		return true;
+	}
+
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Texture.h"
+#include "VertexArray.h"
+
+#include <glm/glm.hpp>
+
+namespace Hazel {
+
+	// A grid of tiles taken from an atlas of equally sized tiles, drawn with Renderer2D::DrawTilemap.
+	// The map is split into chunks of ChunkSize x ChunkSize tiles with a static vertex buffer each.
+	// A chunk is only rebuilt when one of its tiles changed, and only chunks the camera sees are drawn.
+	class Tilemap
+	{
+	public:
+		static constexpr uint32_t ChunkSize = 32;
+		static constexpr uint32_t EmptyTile = UINT32_MAX;
+
+		// tilePixels is the size of a tile in the atlas, tiles are numbered row by row from its top left.
+		// Tile (0, 0) of the map has its bottom left corner at position, every tile is tileSize in world units.
+		Tilemap(uint32_t width, uint32_t height, const Ref<Texture2D>& atlas, const glm::uvec2& tilePixels,
+			const glm::vec3& position = glm::vec3(0.0f), const glm::vec2& tileSize = glm::vec2(1.0f));
+
+		uint32_t GetWidth() const { return m_Width; }
+		uint32_t GetHeight() const { return m_Height; }
+
+		uint32_t GetTile(uint32_t x, uint32_t y) const;
+		void SetTile(uint32_t x, uint32_t y, uint32_t tile);
+		// every tile at once, width * height of them row by row from the bottom
+		void SetTiles(const std::vector<uint32_t>& tiles);
+
+		const glm::vec3& GetPosition() const { return m_Position; }
+		void SetPosition(const glm::vec3& position);
+
+		const Ref<Texture2D>& GetAtlas() const { return m_Atlas; }
+	private:
+		struct TileVertex
+		{
+			glm::vec3 Position;
+			glm::vec2 TexCoord;
+		};
+
+		struct Chunk
+		{
+			Ref<VertexArray> ChunkVertexArray;
+			Ref<VertexBuffer> ChunkVertexBuffer;
+			uint32_t Capacity = 0; // bytes
+			uint32_t QuadCount = 0;
+			bool Dirty = true;
+		};
+
+		void MarkAllDirty();
+		// false when it cannot be built yet, while the atlas is still loading
+		bool UpdateChunk(uint32_t chunkX, uint32_t chunkY);
+	private:
+		uint32_t m_Width, m_Height;
+		uint32_t m_ChunksX, m_ChunksY;
+		std::vector<uint32_t> m_Tiles;
+		std::vector<Chunk> m_Chunks;
+
+		Ref<Texture2D> m_Atlas;
+		glm::uvec2 m_TilePixels;
+		glm::vec3 m_Position;
+		glm::vec2 m_TileSize;
+
+		Ref<IndexBuffer> m_IndexBuffer; // shared by every chunk
+		std::vector<TileVertex> m_Vertices; // scratch for rebuilding a chunk
+
+		friend class Renderer2D;
+	};
+
+}
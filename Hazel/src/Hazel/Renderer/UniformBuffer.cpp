@@ -0,0 +1,27 @@
+#include "hzpch.h"
+#include "UniformBuffer.h"
+
+#include "Renderer.h"
+#include "Platform/OpenGL/OpenGLUniformBuffer.h"
+#include "Platform/Null/NullUniformBuffer.h"
+
+namespace Hazel {
+
+    Ref<UniformBuffer> UniformBuffer::Create(uint32_t size, uint32_t binding)
+    {
+        switch (Renderer::GetAPI())
+        {
+        case RendererAPI::API::None:
+            HZ_CORE_ASSERT(false, "RendererAPI::None is not supported!");
+            return nullptr;
+        case RendererAPI::API::OpenGL:
+            return CreateRef<OpenGLUniformBuffer>(size, binding);
+        case RendererAPI::API::Null:
+            return CreateRef<NullUniformBuffer>(size, binding);
+        }
+
+        HZ_CORE_ASSERT(false, "Unknown renderer API!");
+        return nullptr;
+    }
+
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+namespace Hazel {
+
+	class UniformBuffer
+	{
+	public:
+		virtual ~UniformBuffer() {}
+
+		virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) = 0;
+
+		// binding is the uniform block binding point the buffer is attached to
+		static Ref<UniformBuffer> Create(uint32_t size, uint32_t binding);
+	};
+
+}
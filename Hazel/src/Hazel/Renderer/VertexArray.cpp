@@ -3,6 +3,7 @@
 #include "Renderer.h"
 
 #include "Platform/OpenGL/OpenGLVertexArray.h"
+#include "Platform/Null/NullVertexArray.h"
 
 namespace Hazel {
 
@@ -15,6 +16,8 @@ namespace Hazel {
             return nullptr;
         case RendererAPI::API::OpenGL:
             return std::make_shared<OpenGLVertexArray>();
+        case RendererAPI::API::Null:
+            return std::make_shared<NullVertexArray>();
         }
 
         HZ_CORE_ASSERT(false, "Unknown renderer API!");
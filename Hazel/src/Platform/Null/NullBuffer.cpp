@@ -0,0 +1,64 @@
+#include "hzpch.h"
+#include "NullBuffer.h"
+
+#include "Hazel/Renderer/RendererAPI.h"
+
+namespace Hazel {
+
+	NullVertexBuffer::NullVertexBuffer(uint32_t size)
+		: m_Size(size)
+	{
+	}
+
+	NullVertexBuffer::NullVertexBuffer(float* vertices, uint32_t size)
+		: m_Size(size)
+	{
+		RendererAPI::GetCounters().UploadedBytes += size;
+	}
+
+	void NullVertexBuffer::SetData(const void* data, uint32_t size)
+	{
+		HZ_CORE_ASSERT(size <= m_Size, "Data does not fit in the vertex buffer!");
+		RendererAPI::GetCounters().UploadedBytes += size;
+	}
+
+	// ------------------------------------------
+
+	NullIndexBuffer::NullIndexBuffer(uint32_t* indices, uint32_t count)
+		: m_Count(count)
+	{
+		RendererAPI::GetCounters().UploadedBytes += count * sizeof(uint32_t);
+	}
+
+	// ------------------------------------------
+
+	NullStreamVertexBuffer::NullStreamVertexBuffer(uint32_t size)
+		: m_Memory(size)
+	{
+	}
+
+	void NullStreamVertexBuffer::SetData(const void* data, uint32_t size)
+	{
+		HZ_CORE_ASSERT(false, "Stream vertex buffers are written through Map!");
+	}
+
+	BufferSpan NullStreamVertexBuffer::Map(uint32_t size)
+	{
+		HZ_CORE_ASSERT(size <= m_Memory.size(), "Stream buffer region is too small!");
+		return { m_Memory.data(), size, 0 };
+	}
+
+	// ------------------------------------------
+
+	NullStreamIndexBuffer::NullStreamIndexBuffer(uint32_t count)
+		: m_Memory(count)
+	{
+	}
+
+	BufferSpan NullStreamIndexBuffer::Map(uint32_t count)
+	{
+		HZ_CORE_ASSERT(count <= m_Memory.size(), "Stream buffer region is too small!");
+		return { m_Memory.data(), count * (uint32_t)sizeof(uint32_t), 0 };
+	}
+
+}
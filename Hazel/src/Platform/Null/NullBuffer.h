@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Hazel/Renderer/Buffer.h"
+
+namespace Hazel {
+
+	class NullVertexBuffer : public VertexBuffer
+	{
+	public:
+		NullVertexBuffer(uint32_t size);
+		NullVertexBuffer(float* vertices, uint32_t size);
+
+		virtual void Bind() const override {}
+		virtual void Unbind() const override {}
+
+		virtual void SetData(const void* data, uint32_t size) override;
+
+		virtual const BufferLayout& GetLayout() const override { return m_Layout; }
+		virtual void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
+	private:
+		uint32_t m_Size;
+		BufferLayout m_Layout;
+	};
+
+	class NullIndexBuffer : public IndexBuffer
+	{
+	public:
+		NullIndexBuffer(uint32_t* indices, uint32_t count);
+
+		virtual uint32_t GetCount() const { return m_Count; }
+
+		virtual void Bind() const override {}
+		virtual void Unbind() const override {}
+	private:
+		uint32_t m_Count;
+	};
+
+	// one region, handed out again on every Map since nothing reads it
+	class NullStreamVertexBuffer : public StreamVertexBuffer
+	{
+	public:
+		NullStreamVertexBuffer(uint32_t size);
+
+		virtual void Bind() const override {}
+		virtual void Unbind() const override {}
+
+		virtual void SetData(const void* data, uint32_t size) override;
+		virtual BufferSpan Map(uint32_t size) override;
+		virtual void Commit(uint32_t size) override {}
+
+		virtual const BufferLayout& GetLayout() const override { return m_Layout; }
+		virtual void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
+	private:
+		std::vector<uint8_t> m_Memory;
+		BufferLayout m_Layout;
+	};
+
+	class NullStreamIndexBuffer : public StreamIndexBuffer
+	{
+	public:
+		NullStreamIndexBuffer(uint32_t count);
+
+		virtual uint32_t GetCount() const { return (uint32_t)m_Memory.size(); }
+
+		virtual void Bind() const override {}
+		virtual void Unbind() const override {}
+
+		virtual BufferSpan Map(uint32_t count) override;
+	private:
+		std::vector<uint32_t> m_Memory;
+	};
+
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Hazel/Renderer/GraphicsContext.h"
+
+namespace Hazel {
+
+	class NullContext : public GraphicsContext
+	{
+	public:
+		virtual void Init() override {}
+		virtual void SwapBuffers() override {}
+
+		virtual void MakeCurrent() override {}
+		virtual void ReleaseCurrent() override {}
+	};
+
+}
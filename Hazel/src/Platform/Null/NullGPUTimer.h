@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Hazel/Renderer/GPUTimer.h"
+
+namespace Hazel {
+
+	// there is no GPU work to time
+	class NullGPUTimer : public GPUTimer
+	{
+	public:
+		virtual void Begin() override {}
+		virtual void End() override {}
+
+		virtual float GetElapsedMillis() const override { return 0.0f; }
+	};
+
+}
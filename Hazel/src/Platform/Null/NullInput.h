@@ -0,0 +1,18 @@
+#pragma once
+
+#include "Hazel/Core/Input.h"
+
+namespace Hazel {
+
+	// nothing is ever pressed and the mouse stays in the corner
+	class NullInput : public Input
+	{
+	protected:
+		virtual bool IsKeyPressedImpl(int keycode) override { return false; }
+		virtual bool IsMouseButtonPressedImpl(int button) override { return false; }
+		virtual float GetMouseXImpl() override { return 0.0f; }
+		virtual float GetMouseYImpl() override { return 0.0f; }
+		virtual std::pair<float, float> GetMousePositionImpl() override { return { 0.0f, 0.0f }; }
+	};
+
+}
@@ -0,0 +1,55 @@
+#include "hzpch.h"
+#include "NullRendererAPI.h"
+
+namespace Hazel {
+
+	void NullRendererAPI::Init()
+	{
+		HZ_CORE_INFO("Null renderer: nothing will be drawn");
+	}
+
+	void NullRendererAPI::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		GetCounters().StateChanges++;
+	}
+
+	void NullRendererAPI::SetClearColor(const glm::vec4& color)
+	{
+	}
+
+	void NullRendererAPI::Clear()
+	{
+	}
+
+	void NullRendererAPI::SetDepthFuncLessThanOrEqualTo()
+	{
+		GetCounters().StateChanges++;
+	}
+
+	void NullRendererAPI::SetDepthFuncLessThan()
+	{
+		GetCounters().StateChanges++;
+	}
+
+	void NullRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t firstIndex, uint32_t baseVertex)
+	{
+		// same accounting as the OpenGL backend
+		uint32_t count = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
+		GetCounters().DrawCalls++;
+		GetCounters().Indices += count;
+	}
+
+	void NullRendererAPI::DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t instanceCount, uint32_t indexCount, uint32_t baseInstance)
+	{
+		uint32_t count = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
+		GetCounters().DrawCalls++;
+		GetCounters().Indices += count * instanceCount;
+	}
+
+	uint32_t NullRendererAPI::GetMaxTextureSlots()
+	{
+		// what desktop GPUs commonly report, keeps batch sizes comparable to a real run
+		return 32;
+	}
+
+}
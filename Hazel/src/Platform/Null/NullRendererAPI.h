@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Hazel/Renderer/RendererAPI.h"
+
+namespace Hazel {
+
+	// Accepts every call without a GPU, only the counters are updated
+	class NullRendererAPI : public RendererAPI
+	{
+	public:
+		virtual void Init() override;
+		virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+		virtual void SetClearColor(const glm::vec4& color) override;
+		virtual void Clear() override;
+
+		virtual void SetDepthFuncLessThanOrEqualTo() override;
+		virtual void SetDepthFuncLessThan() override;
+
+		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0, uint32_t firstIndex = 0, uint32_t baseVertex = 0) override;
+		virtual void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t instanceCount, uint32_t indexCount = 0, uint32_t baseInstance = 0) override;
+
+		virtual uint32_t GetMaxTextureSlots() override;
+	};
+
+}
@@ -0,0 +1,28 @@
+#include "hzpch.h"
+#include "NullShader.h"
+
+#include "Hazel/Renderer/RendererAPI.h"
+
+namespace Hazel {
+
+	NullShader::NullShader(const std::string& filepath)
+	{
+		// same naming as the OpenGL shader: the file name without its extension
+		auto lastSlash = filepath.find_last_of("/\\");
+		lastSlash = lastSlash == std::string::npos ? 0 : lastSlash + 1;
+		auto lastDot = filepath.rfind('.');
+		auto count = lastDot == std::string::npos ? filepath.size() - lastSlash : lastDot - lastSlash;
+		m_Name = filepath.substr(lastSlash, count);
+	}
+
+	NullShader::NullShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc)
+		: m_Name(name)
+	{
+	}
+
+	void NullShader::Bind() const
+	{
+		RendererAPI::GetCounters().StateChanges++;
+	}
+
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Hazel/Renderer/Shader.h"
+
+namespace Hazel {
+
+	// Never reads or compiles its source, every uniform resolves and setting it does nothing
+	class NullShader : public Shader
+	{
+	public:
+		NullShader(const std::string& filepath);
+		NullShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
+
+		virtual void Bind() const override;
+		virtual void Unbind() const override {}
+
+		virtual void SetMat4(const std::string& name, const glm::mat4& value) override {}
+		virtual void SetFloat4(const std::string& name, const glm::vec4& value) override {}
+		virtual void SetFloat3(const std::string& name, const glm::vec3& value) override {}
+		virtual void SetFloat(const std::string& name, float value) override {}
+		virtual void SetInt(const std::string& name, int value) override {}
+		virtual void SetIntArray(const std::string& name, int* values, uint32_t count) override {}
+
+		virtual UniformHandle GetUniformHandle(const std::string& name) const override { return 0; }
+
+		virtual void SetMat4(UniformHandle handle, const glm::mat4& value) override {}
+		virtual void SetFloat4(UniformHandle handle, const glm::vec4& value) override {}
+		virtual void SetFloat3(UniformHandle handle, const glm::vec3& value) override {}
+		virtual void SetFloat(UniformHandle handle, float value) override {}
+		virtual void SetInt(UniformHandle handle, int value) override {}
+		virtual void SetIntArray(UniformHandle handle, int* values, uint32_t count) override {}
+
+		virtual const std::string& GetName() const override { return m_Name; }
+	private:
+		std::string m_Name;
+	};
+
+}
@@ -0,0 +1,71 @@
+#include "hzpch.h"
+#include "NullTexture.h"
+
+#include "Hazel/Renderer/RendererAPI.h"
+
+#include "stb_image.h"
+
+namespace Hazel {
+
+	// only reads the image header, a missing file becomes a 1x1 texture
+	static void ReadImageSize(const std::string& path, uint32_t& width, uint32_t& height)
+	{
+		int imageWidth = 1, imageHeight = 1, channels = 0;
+		if (!stbi_info(path.c_str(), &imageWidth, &imageHeight, &channels))
+		{
+			HZ_CORE_WARN("Null texture: could not read the size of '{0}': {1}", path, stbi_failure_reason());
+			imageWidth = imageHeight = 1;
+		}
+		width = (uint32_t)imageWidth;
+		height = (uint32_t)imageHeight;
+	}
+
+	/////////////////////////////////////////////////////////////////
+	/// NullTexture2D ///////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////
+
+	NullTexture2D::NullTexture2D(uint32_t width, uint32_t height)
+		: m_Width(width), m_Height(height)
+	{
+	}
+
+	NullTexture2D::NullTexture2D(const std::string& path)
+	{
+		ReadImageSize(path, m_Width, m_Height);
+	}
+
+	void NullTexture2D::SetData(void* data, uint32_t size)
+	{
+		HZ_CORE_ASSERT(size == m_Width * m_Height * 4, "Data must be entire texture!");
+		RendererAPI::GetCounters().UploadedBytes += size;
+	}
+
+	void NullTexture2D::Bind(uint32_t slot) const
+	{
+		RendererAPI::GetCounters().StateChanges++;
+	}
+
+	void NullTexture2D::SetImage(uint32_t width, uint32_t height, uint32_t channels, const void* pixels)
+	{
+		m_Width = width;
+		m_Height = height;
+		RendererAPI::GetCounters().UploadedBytes += width * height * channels;
+	}
+
+	/////////////////////////////////////////////////////////////////
+	/// NullTextureCubeMap //////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////
+
+	NullTextureCubeMap::NullTextureCubeMap(const std::vector<std::string>& filepaths)
+		: m_Width(1), m_Height(1)
+	{
+		HZ_CORE_ASSERT(filepaths.size() == 6, "Exactly 6 filepaths should be provided!");
+		ReadImageSize(filepaths[0], m_Width, m_Height);
+	}
+
+	void NullTextureCubeMap::Bind(uint32_t slot) const
+	{
+		RendererAPI::GetCounters().StateChanges++;
+	}
+
+}
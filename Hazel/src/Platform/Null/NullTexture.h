@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Hazel/Renderer/Texture.h"
+
+namespace Hazel {
+
+	// Images loaded from disk keep their size, their pixels are never decoded
+	class NullTexture2D : public Texture2D
+	{
+	public:
+		NullTexture2D(uint32_t width, uint32_t height);
+		NullTexture2D(const std::string& path);
+
+		inline virtual uint32_t GetWidth() const override { return m_Width; }
+		inline virtual uint32_t GetHeight() const override { return m_Height; }
+		inline virtual uint32_t GetRendererID() const override { return 0; }
+		virtual void SetData(void* data, uint32_t size) override;
+
+		virtual void Bind(uint32_t slot = 0) const override;
+	protected:
+		virtual void SetImage(uint32_t width, uint32_t height, uint32_t channels, const void* pixels) override;
+	private:
+		uint32_t m_Width, m_Height;
+	};
+
+	class NullTextureCubeMap : public TextureCubeMap
+	{
+	public:
+		NullTextureCubeMap(const std::vector<std::string>& filepaths);
+
+		inline virtual uint32_t GetWidth() const override { return m_Width; }
+		inline virtual uint32_t GetHeight() const override { return m_Height; }
+		inline virtual uint32_t GetRendererID() const override { return 0; }
+		virtual void SetData(void* data, uint32_t size) override {}
+
+		virtual void Bind(uint32_t slot = 0) const override;
+	private:
+		uint32_t m_Width, m_Height;
+	};
+
+}
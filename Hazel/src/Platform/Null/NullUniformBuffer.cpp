@@ -0,0 +1,19 @@
+#include "hzpch.h"
+#include "NullUniformBuffer.h"
+
+#include "Hazel/Renderer/RendererAPI.h"
+
+namespace Hazel {
+
+	NullUniformBuffer::NullUniformBuffer(uint32_t size, uint32_t binding)
+		: m_Size(size)
+	{
+	}
+
+	void NullUniformBuffer::SetData(const void* data, uint32_t size, uint32_t offset)
+	{
+		HZ_CORE_ASSERT(offset + size <= m_Size, "Data does not fit in the uniform buffer!");
+		RendererAPI::GetCounters().UploadedBytes += size;
+	}
+
+}
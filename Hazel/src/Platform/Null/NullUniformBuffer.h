@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Hazel/Renderer/UniformBuffer.h"
+
+namespace Hazel {
+
+	class NullUniformBuffer : public UniformBuffer
+	{
+	public:
+		NullUniformBuffer(uint32_t size, uint32_t binding);
+
+		virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) override;
+	private:
+		uint32_t m_Size;
+	};
+
+}
@@ -0,0 +1,12 @@
+#include "hzpch.h"
+#include "NullWindow.h"
+
+namespace Hazel {
+
+	NullWindow::NullWindow(const WindowProps& props)
+		: m_Width(props.Width), m_Height(props.Height)
+	{
+		HZ_CORE_INFO("Creating headless window {0} ({1}, {2})", props.Title, props.Width, props.Height);
+	}
+
+}
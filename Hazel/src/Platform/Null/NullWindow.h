@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Hazel/Core/Window.h"
+#include "NullContext.h"
+
+namespace Hazel {
+
+	// Headless window for the null renderer: never shown and never sends events
+	class NullWindow : public Window
+	{
+	public:
+		NullWindow(const WindowProps& props);
+
+		void OnUpdate() override {}
+
+		inline unsigned int GetWidth() const override { return m_Width; }
+		inline unsigned int GetHeight() const override { return m_Height; }
+
+		// Window attributes
+		inline void SetEventCallback(const EventCallbackFn& callback) override {}
+		inline virtual void SetVSync(bool enable) override { m_VSync = enable; }
+		inline virtual bool IsVSync() const override { return m_VSync; }
+
+		inline virtual void EnableCursor(bool enable) override { m_CursorEnabled = enable; }
+		inline virtual bool IsCursorEnabled() const override { return m_CursorEnabled; }
+
+		inline virtual void* GetNativeWindow() const override { return nullptr; }
+		inline virtual GraphicsContext& GetContext() const override { return m_Context; }
+	private:
+		unsigned int m_Width, m_Height;
+		bool m_VSync = false;
+		bool m_CursorEnabled = true;
+
+		mutable NullContext m_Context;
+	};
+
+}
@@ -1,63 +1,296 @@
 #include "hzpch.h"
 #include "OpenGLBuffer.h"
 
+#include "Hazel/Renderer/RendererAPI.h"
+
 #include <glad/glad.h>
 
 namespace Hazel {
 
+	// the GL calls are recorded when the render thread runs, see RenderThread
+
+	static void CreateBuffer(const RendererHandle& handle, uint32_t size, const void* data, GLenum usage)
+	{
+		if (data)
+			RendererAPI::GetCounters().UploadedBytes += size;
+		RenderThread::Submit([handle, size, data, usage]()
+		{
+			// named calls leave the bindings alone, binding an index buffer here would change
+			// the element buffer of whatever vertex array is bound
+			GLuint id = 0;
+			glCreateBuffers(1, &id);
+			glNamedBufferData(id, size, data, usage);
+			*handle = id;
+		});
+	}
+
+	static void DeleteBuffer(const RendererHandle& handle)
+	{
+		RenderThread::Submit([handle]()
+		{
+			GLuint id = *handle;
+			glDeleteBuffers(1, &id);
+		});
+	}
+
+	OpenGLVertexBuffer::OpenGLVertexBuffer(uint32_t size)
+		: m_RendererID(CreateRendererHandle())
+	{
+		HZ_PROFILE_FUNCTION();
+		CreateBuffer(m_RendererID, size, nullptr, GL_DYNAMIC_DRAW);
+	}
+
 	OpenGLVertexBuffer::OpenGLVertexBuffer(float* vertices, uint32_t size)
+		: m_RendererID(CreateRendererHandle())
 	{
 		HZ_PROFILE_FUNCTION();
-		glCreateBuffers(1, &m_RendererID);
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
+		CreateBuffer(m_RendererID, size, RenderThread::CopyCommandData(vertices, size), GL_STATIC_DRAW);
 	}
 
 	OpenGLVertexBuffer::~OpenGLVertexBuffer()
 	{
 		HZ_PROFILE_FUNCTION();
-		glDeleteBuffers(1, &m_RendererID);
+		DeleteBuffer(m_RendererID);
 	}
 
 	void OpenGLVertexBuffer::Bind() const
 	{
 		HZ_PROFILE_FUNCTION();
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+		RenderThread::Submit([id = m_RendererID]() { glBindBuffer(GL_ARRAY_BUFFER, *id); });
 	}
 
 	void OpenGLVertexBuffer::Unbind() const
 	{
 		HZ_PROFILE_FUNCTION();
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		RenderThread::Submit([]() { glBindBuffer(GL_ARRAY_BUFFER, 0); });
+	}
+
+	void OpenGLVertexBuffer::SetData(const void* data, uint32_t size)
+	{
+		HZ_PROFILE_FUNCTION();
+		RendererAPI::GetCounters().UploadedBytes += size;
+		const void* commandData = RenderThread::CopyCommandData(data, size);
+		RenderThread::Submit([id = m_RendererID, commandData, size]()
+		{
+			glNamedBufferSubData(*id, 0, size, commandData);
+		});
 	}
 
 	// ------------------------------------------
 
 	OpenGLIndexBuffer::OpenGLIndexBuffer(uint32_t* indices, uint32_t count)
-		:m_Count(count)
+		: m_RendererID(CreateRendererHandle()), m_Count(count)
 	{
 		HZ_PROFILE_FUNCTION();
-		glCreateBuffers(1, &m_RendererID);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(uint32_t), indices, GL_STATIC_DRAW);
+		uint32_t size = count * sizeof(uint32_t);
+		CreateBuffer(m_RendererID, size, RenderThread::CopyCommandData(indices, size), GL_STATIC_DRAW);
 	}
 
 	OpenGLIndexBuffer::~OpenGLIndexBuffer()
 	{
 		HZ_PROFILE_FUNCTION();
-		glDeleteBuffers(1, &m_RendererID);
+		DeleteBuffer(m_RendererID);
 	}
 
 	void OpenGLIndexBuffer::Bind() const
 	{
 		HZ_PROFILE_FUNCTION();
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
+		RenderThread::Submit([id = m_RendererID]() { glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *id); });
 	}
 
 	void OpenGLIndexBuffer::Unbind() const
 	{
 		HZ_PROFILE_FUNCTION();
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		RenderThread::Submit([]() { glBindBuffer(GL_ARRAY_BUFFER, 0); });
+	}
+
+	// ------------------------------------------
+
+	struct OpenGLStreamBuffer::State
+	{
+		RendererHandle RendererID = CreateRendererHandle();
+		uint8_t* Memory = nullptr; // mapped for the whole lifetime of the buffer
+
+		// render thread only, a region has a fence from when it is left until the fence signaled
+		std::array<GLsync, RegionCount> Fences = {};
+		// set by the recording thread when it leaves a region, cleared by the render thread
+		// once the fence signaled
+		std::array<std::atomic<bool>, RegionCount> Busy = {};
+
+		// false when the fence did not signal within timeout nanoseconds
+		bool Retire(uint32_t region, GLuint64 timeout)
+		{
+			GLsync fence = Fences[region];
+			HZ_CORE_ASSERT(fence, "Stream buffer region was not fenced!");
+
+			GLenum result = glClientWaitSync(fence, timeout ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, timeout);
+			if (result == GL_TIMEOUT_EXPIRED)
+				return false;
+			HZ_CORE_ASSERT(result != GL_WAIT_FAILED, "Waiting for a stream buffer fence failed!");
+
+			glDeleteSync(fence);
+			Fences[region] = nullptr;
+			Busy[region] = false;
+			return true;
+		}
+	};
+
+	OpenGLStreamBuffer::OpenGLStreamBuffer(uint32_t regionSize)
+		: m_State(CreateRef<State>()), m_RegionSize(regionSize)
+	{
+		HZ_PROFILE_FUNCTION();
+		uint32_t size = regionSize * RegionCount;
+		RenderThread::Submit([state = m_State, size]()
+		{
+			// coherent, so writes become visible to the GPU without flushing them
+			GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+			GLuint id = 0;
+			glCreateBuffers(1, &id);
+			glNamedBufferStorage(id, size, nullptr, flags);
+			state->Memory = static_cast<uint8_t*>(glMapNamedBufferRange(id, 0, size, flags));
+			*state->RendererID = id;
+		});
+		// the memory is written as soon as the buffer exists
+		RenderThread::Flush();
+		HZ_CORE_ASSERT(m_State->Memory, "Could not map the stream buffer!");
+	}
+
+	OpenGLStreamBuffer::~OpenGLStreamBuffer()
+	{
+		HZ_PROFILE_FUNCTION();
+		RenderThread::Submit([state = m_State]()
+		{
+			for (GLsync& fence : state->Fences)
+			{
+				if (fence)
+					glDeleteSync(fence);
+			}
+
+			GLuint id = *state->RendererID;
+			glUnmapNamedBuffer(id);
+			glDeleteBuffers(1, &id);
+		});
+	}
+
+	BufferSpan OpenGLStreamBuffer::Map(uint32_t size, uint32_t alignment)
+	{
+		HZ_PROFILE_FUNCTION();
+		auto align = [alignment](uint32_t offset) { return (offset + alignment - 1) / alignment * alignment; };
+
+		uint32_t regionStart = m_Region * m_RegionSize;
+		uint32_t offset = align(regionStart + m_Offset);
+		if (offset + size > regionStart + m_RegionSize)
+		{
+			NextRegion();
+			regionStart = m_Region * m_RegionSize;
+			offset = align(regionStart);
+			HZ_CORE_ASSERT(offset + size <= regionStart + m_RegionSize, "Stream buffer region is too small!");
+		}
+
+		m_Offset = offset + size - regionStart;
+		m_MappedOffset = offset;
+		m_MappedSize = size;
+		return { m_State->Memory + offset, size, offset };
+	}
+
+	void OpenGLStreamBuffer::Commit(uint32_t size)
+	{
+		HZ_CORE_ASSERT(size <= m_MappedSize, "Committing more than the last Map handed out!");
+
+		// nothing reads past size, so the next Map may start right there
+		m_Offset = m_MappedOffset + size - m_Region * m_RegionSize;
+		m_MappedSize = 0;
+	}
+
+	const RendererHandle& OpenGLStreamBuffer::GetRendererID() const
+	{
+		return m_State->RendererID;
+	}
+
+	void OpenGLStreamBuffer::NextRegion()
+	{
+		// the fence goes in after every draw reading from the region that is left
+		m_State->Busy[m_Region] = true;
+		RenderThread::Submit([state = m_State, region = m_Region]()
+		{
+			state->Fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+			// and the older ones the GPU finished meanwhile are retired, without waiting
+			for (uint32_t i = 0; i < RegionCount; i++)
+			{
+				if (i != region && state->Fences[i])
+					state->Retire(i, 0);
+			}
+		});
+
+		m_Region = (m_Region + 1) % RegionCount;
+		m_Offset = 0;
+
+		if (m_State->Busy[m_Region])
+		{
+			// the GPU is a whole ring behind, nothing to do but wait for it. With the render
+			// thread running the region may also have signaled already without anyone noticing
+			HZ_PROFILE_SCOPE("Wait for region - OpenGLStreamBuffer::NextRegion");
+			RenderThread::Submit([state = m_State, region = m_Region]()
+			{
+				while (!state->Retire(region, 1000000000))
+					;
+			});
+			RenderThread::Flush();
+		}
+	}
+
+	OpenGLStreamVertexBuffer::OpenGLStreamVertexBuffer(uint32_t size)
+		: m_Buffer(size)
+	{
+	}
+
+	void OpenGLStreamVertexBuffer::Bind() const
+	{
+		HZ_PROFILE_FUNCTION();
+		RenderThread::Submit([id = m_Buffer.GetRendererID()]() { glBindBuffer(GL_ARRAY_BUFFER, *id); });
+	}
+
+	void OpenGLStreamVertexBuffer::Unbind() const
+	{
+		HZ_PROFILE_FUNCTION();
+		RenderThread::Submit([]() { glBindBuffer(GL_ARRAY_BUFFER, 0); });
+	}
+
+	void OpenGLStreamVertexBuffer::SetData(const void* data, uint32_t size)
+	{
+		HZ_CORE_ASSERT(false, "Stream vertex buffers are written through Map!");
+	}
+
+	BufferSpan OpenGLStreamVertexBuffer::Map(uint32_t size)
+	{
+		// whole vertices, so the offset works as a base vertex
+		uint32_t stride = m_Layout.GetStride();
+		return m_Buffer.Map(size, stride ? stride : 4);
+	}
+
+	// ------------------------------------------
+
+	OpenGLStreamIndexBuffer::OpenGLStreamIndexBuffer(uint32_t count)
+		: m_Buffer(count * sizeof(uint32_t)), m_Count(count)
+	{
+	}
+
+	void OpenGLStreamIndexBuffer::Bind() const
+	{
+		HZ_PROFILE_FUNCTION();
+		RenderThread::Submit([id = m_Buffer.GetRendererID()]() { glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *id); });
+	}
+
+	void OpenGLStreamIndexBuffer::Unbind() const
+	{
+		HZ_PROFILE_FUNCTION();
+		RenderThread::Submit([]() { glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); });
+	}
+
+	BufferSpan OpenGLStreamIndexBuffer::Map(uint32_t count)
+	{
+		return m_Buffer.Map(count * sizeof(uint32_t), sizeof(uint32_t));
 	}
 
 }
\ No newline at end of file
@@ -1,22 +1,26 @@
 #pragma once
 
 #include "Hazel/Renderer/Buffer.h"
+#include "Hazel/Renderer/RenderThread.h"
 
 namespace Hazel {
 
 	class OpenGLVertexBuffer : public VertexBuffer
 	{
 	public:
+		OpenGLVertexBuffer(uint32_t size);
 		OpenGLVertexBuffer(float* vertices, uint32_t size);
 		virtual ~OpenGLVertexBuffer();
 
 		virtual void Bind() const override;
 		virtual void Unbind() const override;
 
+		virtual void SetData(const void* data, uint32_t size) override;
+
 		virtual const BufferLayout& GetLayout() const override { return m_Layout; }
 		virtual void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
 	private:
-		uint32_t m_RendererID;
+		RendererHandle m_RendererID;
 		BufferLayout m_Layout;
 	};
 
@@ -31,7 +35,74 @@ namespace Hazel {
 		virtual void Bind() const override;
 		virtual void Unbind() const override;
 	private:
-		uint32_t m_RendererID;
+		RendererHandle m_RendererID;
+		uint32_t m_Count;
+	};
+
+	// Ring of RegionCount regions in one persistently mapped buffer, behind both stream buffers.
+	// Map hands out the current region until it is full, then fences it and moves on to the
+	// next. A region is only reused once its fence signaled, when the GPU gets a whole ring
+	// behind Map waits for it. The recording thread writes the mapped memory directly, only
+	// the fences go through the render thread.
+	class OpenGLStreamBuffer
+	{
+	public:
+		static constexpr uint32_t RegionCount = 3;
+
+		OpenGLStreamBuffer(uint32_t regionSize);
+		~OpenGLStreamBuffer();
+
+		// offset is a multiple of alignment
+		BufferSpan Map(uint32_t size, uint32_t alignment);
+		// shrinks the last mapping to its first size bytes
+		void Commit(uint32_t size);
+
+		const RendererHandle& GetRendererID() const;
+	private:
+		void NextRegion();
+	private:
+		struct State; // shared with the recorded commands
+		Ref<State> m_State;
+		uint32_t m_RegionSize;
+		uint32_t m_Region = 0;
+		uint32_t m_Offset = 0; // into the current region
+		uint32_t m_MappedOffset = 0, m_MappedSize = 0; // the last mapping, until committed
+	};
+
+	class OpenGLStreamVertexBuffer : public StreamVertexBuffer
+	{
+	public:
+		OpenGLStreamVertexBuffer(uint32_t size);
+
+		virtual void Bind() const override;
+		virtual void Unbind() const override;
+
+		// the data would have to land at the start of the buffer, which the GPU may still read
+		virtual void SetData(const void* data, uint32_t size) override;
+		virtual BufferSpan Map(uint32_t size) override;
+		virtual void Commit(uint32_t size) override { m_Buffer.Commit(size); }
+
+		virtual const BufferLayout& GetLayout() const override { return m_Layout; }
+		virtual void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
+	private:
+		OpenGLStreamBuffer m_Buffer;
+		BufferLayout m_Layout;
+	};
+
+	class OpenGLStreamIndexBuffer : public StreamIndexBuffer
+	{
+	public:
+		OpenGLStreamIndexBuffer(uint32_t count);
+
+		virtual uint32_t GetCount() const { return m_Count; }
+
+		virtual void Bind() const override;
+		virtual void Unbind() const override;
+
+		virtual BufferSpan Map(uint32_t count) override;
+	private:
+		OpenGLStreamBuffer m_Buffer;
 		uint32_t m_Count;
 	};
+
 }
\ No newline at end of file
@@ -2,7 +2,7 @@
 #include "OpenGLContext.h"
 
 #include <GLFW/glfw3.h>
-#include <Glad/Glad.h>
+#include <glad/glad.h>
 
 namespace Hazel {
 
@@ -38,4 +38,14 @@ namespace Hazel {
 		glfwSwapBuffers(m_WindowHandle);
 	}
 
+	void OpenGLContext::MakeCurrent()
+	{
+		glfwMakeContextCurrent(m_WindowHandle);
+	}
+
+	void OpenGLContext::ReleaseCurrent()
+	{
+		glfwMakeContextCurrent(nullptr);
+	}
+
 }
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include "hzpch.h"
+#include "OpenGLGPUTimer.h"
+#include "Hazel/Renderer/RenderThread.h"
+
+#include <glad/glad.h>
+
+namespace Hazel {
+
+	OpenGLGPUTimer::OpenGLGPUTimer()
+		: m_State(CreateRef<QueryState>())
+	{
+		RenderThread::Submit([state = m_State]() { glCreateQueries(GL_TIME_ELAPSED, 2, state->Queries); });
+	}
+
+	OpenGLGPUTimer::~OpenGLGPUTimer()
+	{
+		RenderThread::Submit([state = m_State]() { glDeleteQueries(2, state->Queries); });
+	}
+
+	void OpenGLGPUTimer::Begin()
+	{
+		RenderThread::Submit([state = m_State]()
+		{
+			// the query from two frames ago normally finished long ago, only wait if it did not
+			if (state->InFlight[state->Index])
+				state->Collect(state->Index, true);
+
+			glBeginQuery(GL_TIME_ELAPSED, state->Queries[state->Index]);
+		});
+	}
+
+	void OpenGLGPUTimer::End()
+	{
+		RenderThread::Submit([state = m_State]()
+		{
+			glEndQuery(GL_TIME_ELAPSED);
+			state->InFlight[state->Index] = true;
+
+			// pick up last frame's result if the GPU got to it already
+			state->Index ^= 1;
+			if (state->InFlight[state->Index])
+				state->Collect(state->Index, false);
+		});
+	}
+
+	void OpenGLGPUTimer::QueryState::Collect(uint32_t index, bool wait)
+	{
+		if (!wait)
+		{
+			GLint available = 0;
+			glGetQueryObjectiv(Queries[index], GL_QUERY_RESULT_AVAILABLE, &available);
+			if (!available)
+				return;
+		}
+
+		GLuint64 elapsed = 0;
+		glGetQueryObjectui64v(Queries[index], GL_QUERY_RESULT, &elapsed);
+		ElapsedMillis = elapsed * 1e-6f;
+		InFlight[index] = false;
+	}
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Hazel/Renderer/GPUTimer.h"
+
+#include <atomic>
+
+namespace Hazel {
+
+	// Two GL_TIME_ELAPSED queries used in alternate frames
+	class OpenGLGPUTimer : public GPUTimer
+	{
+	public:
+		OpenGLGPUTimer();
+		virtual ~OpenGLGPUTimer();
+
+		virtual void Begin() override;
+		virtual void End() override;
+
+		virtual float GetElapsedMillis() const override { return m_State->ElapsedMillis; }
+	private:
+		// used by render commands, which may run after the timer is gone
+		struct QueryState
+		{
+			uint32_t Queries[2] = { 0, 0 };
+			bool InFlight[2] = { false, false };
+			uint32_t Index = 0;
+			std::atomic<float> ElapsedMillis = 0.0f;
+
+			void Collect(uint32_t index, bool wait);
+		};
+
+		Ref<QueryState> m_State;
+	};
+
+}
@@ -1,5 +1,6 @@
 #include "hzpch.h"
 #include "OpenGLRendererAPI.h"
+#include "OpenGLStateCache.h"
 
 namespace Hazel {
 
@@ -7,30 +8,71 @@ namespace Hazel {
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glEnable(GL_BLEND);
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-		glBlendEquation(GL_ADD);
+		RenderThread::Submit([]()
+		{
+			glEnable(GL_BLEND);
+			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			glBlendEquation(GL_ADD);
 
-		glEnable(GL_DEPTH_TEST);
+			glEnable(GL_DEPTH_TEST);
+		});
 	}
 
 	void OpenGLRendererAPI::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
 	{
-		glViewport(x, y, width, height);
+		OpenGLStateCache::Viewport(x, y, width, height);
 	}
 
 	void OpenGLRendererAPI::SetClearColor(const glm::vec4& color)
 	{
-		glClearColor(color.r, color.g, color.b, color.a);
+		RenderThread::Submit([color]() { glClearColor(color.r, color.g, color.b, color.a); });
 	}
 
 	void OpenGLRendererAPI::Clear()
 	{
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		RenderThread::Submit([]() { glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); });
 	}
 
-	void OpenGLRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray)
+	void OpenGLRendererAPI::SetDepthFuncLessThanOrEqualTo()
 	{
-		glDrawElements(GL_TRIANGLES, vertexArray->GetIndexBuffer()->GetCount(), GL_UNSIGNED_INT, nullptr);
+		OpenGLStateCache::DepthFunc(GL_LEQUAL);
+	}
+
+	void OpenGLRendererAPI::SetDepthFuncLessThan()
+	{
+		OpenGLStateCache::DepthFunc(GL_LESS);
+	}
+
+	void OpenGLRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t firstIndex, uint32_t baseVertex)
+	{
+		// an index count of 0 draws the whole index buffer
+		uint32_t count = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
+		GetCounters().DrawCalls++;
+		GetCounters().Indices += count;
+		RenderThread::Submit([count, firstIndex, baseVertex]()
+		{
+			const void* indices = (const void*)(uintptr_t)(firstIndex * sizeof(uint32_t));
+			glDrawElementsBaseVertex(GL_TRIANGLES, count, GL_UNSIGNED_INT, indices, baseVertex);
+		});
+	}
+
+	void OpenGLRendererAPI::DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t instanceCount, uint32_t indexCount, uint32_t baseInstance)
+	{
+		uint32_t count = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
+		GetCounters().DrawCalls++;
+		GetCounters().Indices += count * instanceCount;
+		RenderThread::Submit([count, instanceCount, baseInstance]()
+		{
+			glDrawElementsInstancedBaseInstance(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr, instanceCount, baseInstance);
+		});
+	}
+
+	uint32_t OpenGLRendererAPI::GetMaxTextureSlots()
+	{
+		// texture units the fragment shader can sample from
+		GLint maxTextureSlots = 0;
+		RenderThread::Submit([&maxTextureSlots]() { glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &maxTextureSlots); });
+		RenderThread::Flush();
+		return (uint32_t)maxTextureSlots;
 	}	
 }
\ No newline at end of file
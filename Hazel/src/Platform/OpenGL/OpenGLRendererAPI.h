@@ -14,10 +14,13 @@ namespace Hazel {
 		virtual void SetClearColor(const glm::vec4& color) override;
 		virtual void Clear() override;
 
-		virtual inline void SetDepthFuncLessThanOrEqualTo() override { glDepthFunc(GL_LEQUAL); }
-		virtual inline void SetDepthFuncLessThan() override { glDepthFunc(GL_LESS); }
+		virtual void SetDepthFuncLessThanOrEqualTo() override;
+		virtual void SetDepthFuncLessThan() override;
 
-		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray) override;
+		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0, uint32_t firstIndex = 0, uint32_t baseVertex = 0) override;
+		virtual void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t instanceCount, uint32_t indexCount = 0, uint32_t baseInstance = 0) override;
+
+		virtual uint32_t GetMaxTextureSlots() override;
 
 	};
 }
\ No newline at end of file
@@ -1,7 +1,12 @@
 #include "hzpch.h"
 #include "OpenGLShader.h"
+#include "OpenGLStateCache.h"
+#include "Hazel/Renderer/RenderThread.h"
+#include "Hazel/Core/Hash.h"
+#include "Hazel/Core/Timer.h"
 #include <glm/gtc/type_ptr.hpp>
 #include <fstream>
+#include <filesystem>
 #include <glad/glad.h>
 
 
@@ -17,20 +22,68 @@ namespace Hazel {
 		HZ_CORE_ASSERT(false, "Unknown shader type!");
 		return 0;
 	}
+
+	// Created on first use next to the assets, relative to the working directory like every
+	// other asset path. Empty when it cannot be created, which turns the cache off.
+	static const std::string& GetCacheDirectory()
+	{
+		static std::string directory;
+		static bool checked = false;
+		if (checked)
+			return directory;
+		checked = true;
+
+		const char* path = "assets/cache/shader/opengl";
+		std::error_code error;
+		std::filesystem::create_directories(path, error);
+		if (error || !std::filesystem::is_directory(path, error))
+		{
+			std::string reason = error ? error.message() : "not a directory";
+			std::filesystem::path absolute = std::filesystem::absolute(path, error);
+			HZ_CORE_WARN("Shader cache directory '{0}' cannot be created ({1}), program binaries are not cached", absolute.string(), reason);
+			return directory;
+		}
+
+		directory = path;
+		return directory;
+	}
+
+	static bool ProgramBinariesSupported()
+	{
+		static GLint formatCount = -1;
+		if (formatCount == -1)
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+		return formatCount > 0;
+	}
+
+	// binaries are only valid for the exact driver that produced them
+	static const std::string& GetDriverString()
+	{
+		static std::string driver;
+		if (driver.empty())
+		{
+			driver += (const char*)glGetString(GL_VENDOR);
+			driver += (const char*)glGetString(GL_RENDERER);
+			driver += (const char*)glGetString(GL_VERSION);
+		}
+		return driver;
+	}
 	
 	OpenGLShader::OpenGLShader(const std::string& filepath)
 	{
 		HZ_PROFILE_FUNCTION();
-		std::string source = ReadFile(filepath);
-		auto shaderSources = PreProcess(source);
-		Compile(shaderSources);
-
 		// Extract name from the filepath
 		auto lastSlash = filepath.find_last_of("/\\"); // find last forward slash or backslash
 		lastSlash = lastSlash == std::string::npos ? 0 : lastSlash + 1;
 		auto lastDot = filepath.rfind('.'); // rfind looks searches from the right just like find_last_of but rfind only looks for one character
 		auto count = lastDot == std::string::npos ? filepath.size() - lastSlash : lastDot - lastSlash;
 		m_Name = filepath.substr(lastSlash, count);
+
+		std::string source = ReadFile(filepath);
+		auto shaderSources = PreProcess(source);
+		// the uniform locations are needed right away, wait for the program instead of deferring it
+		RenderThread::Submit([this, &shaderSources]() { CreateProgram(shaderSources); });
+		RenderThread::Flush();
 	}
 
 	OpenGLShader::OpenGLShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc)
@@ -40,13 +93,15 @@ namespace Hazel {
 		std::unordered_map<GLenum, std::string> sources;
 		sources[GL_VERTEX_SHADER] = vertexSrc;
 		sources[GL_FRAGMENT_SHADER] = fragmentSrc;
-		Compile(sources);
+		RenderThread::Submit([this, &sources]() { CreateProgram(sources); });
+		RenderThread::Flush();
 	}
 
 	OpenGLShader::~OpenGLShader()
 	{
 		HZ_PROFILE_FUNCTION();
-		glDeleteProgram(m_RendererID);
+		OpenGLStateCache::ForgetProgram(m_RendererID);
+		RenderThread::Submit([id = m_RendererID]() { glDeleteProgram(id); });
 	}
 
 	std::string OpenGLShader::ReadFile(const std::string& filepath)
@@ -94,13 +149,112 @@ namespace Hazel {
 		return shaderSources;
 	}
 
+	void OpenGLShader::CreateProgram(const std::unordered_map<GLenum, std::string>& shaderSources)
+	{
+		HZ_PROFILE_FUNCTION();
+		Timer timer;
+
+		std::string cachePath = GetCachePath(shaderSources);
+		if (!cachePath.empty() && LoadProgramBinary(cachePath))
+		{
+			HZ_CORE_INFO("Shader '{0}' loaded from the binary cache in {1} ms", m_Name, timer.ElapsedMillis());
+		}
+		else
+		{
+			Compile(shaderSources);
+			if (!cachePath.empty() && m_RendererID)
+				SaveProgramBinary(cachePath);
+			HZ_CORE_INFO("Shader '{0}' missed the binary cache, compiled in {1} ms", m_Name, timer.ElapsedMillis());
+		}
+
+		Reflect();
+		Bind();
+	}
+
+	std::string OpenGLShader::GetCachePath(const std::unordered_map<GLenum, std::string>& shaderSources) const
+	{
+		if (!ProgramBinariesSupported() || GetCacheDirectory().empty())
+			return "";
+
+		// hash the stages in a fixed order, the map iteration order is unspecified
+		uint64_t hash = Hash::FNV1a64(GetDriverString());
+		for (GLenum type : { GL_VERTEX_SHADER, GL_FRAGMENT_SHADER })
+		{
+			auto it = shaderSources.find(type);
+			if (it == shaderSources.end())
+				continue;
+			hash = Hash::FNV1a64((const char*)&type, sizeof(type), hash);
+			hash = Hash::FNV1a64(it->second, hash);
+		}
+
+		std::stringstream ss;
+		ss << GetCacheDirectory() << "/" << m_Name << "_" << std::hex << hash << ".glbin";
+		return ss.str();
+	}
+
+	bool OpenGLShader::LoadProgramBinary(const std::string& cachePath)
+	{
+		HZ_PROFILE_FUNCTION();
+		std::ifstream in(cachePath, std::ios::in | std::ios::binary);
+		if (!in)
+			return false;
+
+		// file layout: binary format (GLenum) followed by the program binary
+		GLenum format = 0;
+		in.read((char*)&format, sizeof(format));
+		std::vector<char> binary((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+		in.close();
+
+		GLuint program = glCreateProgram();
+		glProgramBinary(program, format, binary.data(), (GLsizei)binary.size());
+
+		GLint isLinked = 0;
+		glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+		if (isLinked == GL_FALSE)
+		{
+			// usually a driver update, the stale binary gets replaced by the recompiled one
+			HZ_CORE_WARN("Shader '{0}': cached program binary was rejected by the driver, recompiling", m_Name);
+			glDeleteProgram(program);
+			std::error_code error;
+			std::filesystem::remove(cachePath, error);
+			return false;
+		}
+
+		m_RendererID = program;
+		return true;
+	}
+
+	void OpenGLShader::SaveProgramBinary(const std::string& cachePath)
+	{
+		HZ_PROFILE_FUNCTION();
+		GLint length = 0;
+		glGetProgramiv(m_RendererID, GL_PROGRAM_BINARY_LENGTH, &length);
+		if (length == 0)
+			return;
+
+		GLenum format = 0;
+		std::vector<char> binary(length);
+		glGetProgramBinary(m_RendererID, length, &length, &format, binary.data());
+
+		std::ofstream out(cachePath, std::ios::out | std::ios::binary);
+		if (!out)
+		{
+			HZ_CORE_WARN("Could not write shader cache file '{0}'", cachePath);
+			return;
+		}
+		out.write((const char*)&format, sizeof(format));
+		out.write(binary.data(), length);
+	}
+
 	void OpenGLShader::Compile(const std::unordered_map<GLenum, std::string>& shaderSources)
 	{
 		HZ_PROFILE_FUNCTION();
 		GLuint program = glCreateProgram();
+		// needed for glGetProgramBinary to work once the program is linked
+		glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 
 		HZ_CORE_ASSERT(shaderSources.size() <= 2, "We only support 2 shaders for the moment");
-		std::array<GLenum, 2> glShaderIDs;
+		std::array<GLenum, 2> glShaderIDs = {}; // 0 is ignored by glDeleteShader
 
 		int glShaderIDIndex = 0;
 		for (auto& [shaderType, source] : shaderSources)
@@ -155,123 +309,208 @@ namespace Hazel {
 		}
 
 		for (auto id : glShaderIDs)
+		{
 			glDetachShader(program, id);
+			glDeleteShader(id);
+		}
 
 		// only set the ID if all shaders succeeded
 		m_RendererID = program;
+	}
 
-		Bind();
+	void OpenGLShader::Reflect()
+	{
+		HZ_PROFILE_FUNCTION();
+		m_UniformLocations.clear();
+
+		GLint uniformCount = 0, maxNameLength = 0;
+		glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORMS, &uniformCount);
+		glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+		std::vector<GLchar> nameBuffer(maxNameLength);
+		for (GLint i = 0; i < uniformCount; i++)
+		{
+			GLsizei length = 0;
+			GLint arraySize = 0;
+			GLenum type = 0;
+			glGetActiveUniform(m_RendererID, (GLuint)i, maxNameLength, &length, &arraySize, &type, nameBuffer.data());
+
+			std::string name(nameBuffer.data(), length);
+			GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+			if (location == -1)
+				continue; // members of uniform blocks have no location
+
+			auto addLocation = [this](const std::string& uniformName, GLint uniformLocation)
+			{
+				uint32_t hash = Hash::FNV1a(uniformName);
+				HZ_CORE_ASSERT(m_UniformLocations.find(hash) == m_UniformLocations.end(), "Uniform name hash collision!");
+				m_UniformLocations[hash] = uniformLocation;
+			};
+
+			// arrays are reported as "name[0]", make "name" and every element reachable
+			auto bracket = name.find('[');
+			if (bracket != std::string::npos)
+			{
+				std::string baseName = name.substr(0, bracket);
+				addLocation(baseName, location);
+				for (GLint element = 0; element < arraySize; element++)
+				{
+					std::string elementName = baseName + "[" + std::to_string(element) + "]";
+					addLocation(elementName, glGetUniformLocation(m_RendererID, elementName.c_str()));
+				}
+			}
+			else
+				addLocation(name, location);
+		}
 	}
 
 	void OpenGLShader::Bind() const
 	{
 		HZ_PROFILE_FUNCTION();
-		glUseProgram(m_RendererID);
+		OpenGLStateCache::UseProgram(m_RendererID);
 	}
 
 	void OpenGLShader::Unbind() const
 	{
-		glUseProgram(0);
+		OpenGLStateCache::UseProgram(0);
+	}
+
+	UniformHandle OpenGLShader::GetUniformHandle(const std::string& name) const
+	{
+		auto it = m_UniformLocations.find(Hash::FNV1a(name));
+		return it != m_UniformLocations.end() ? it->second : -1;
 	}
 
 	void OpenGLShader::SetMat4(const std::string& name, const glm::mat4& value)
 	{
 		HZ_PROFILE_FUNCTION();
-		UploadUniformMat4(name, value);
+		UploadUniformMat4(GetUniformHandle(name), value);
 	}
 
 	void OpenGLShader::SetFloat4(const std::string& name, const glm::vec4& value)
 	{
 		HZ_PROFILE_FUNCTION();
-		UploadUniformFloat4(name, value);
+		UploadUniformFloat4(GetUniformHandle(name), value);
 	}
 	
 	void OpenGLShader::SetFloat3(const std::string& name, const glm::vec3& value)
 	{
 		HZ_PROFILE_FUNCTION();
-		UploadUniformFloat3(name, value);
+		UploadUniformFloat3(GetUniformHandle(name), value);
 	}
 
 	void OpenGLShader::SetFloat(const std::string& name, float value)
 	{
 		HZ_PROFILE_FUNCTION();
-		UploadUniformFloat(name, value);
+		UploadUniformFloat(GetUniformHandle(name), value);
 	}
 
 	void OpenGLShader::SetInt(const std::string& name, int value)
 	{
 		HZ_PROFILE_FUNCTION();
-		UploadUniformInt(name, value);
+		UploadUniformInt(GetUniformHandle(name), value);
+	}
+
+	void OpenGLShader::SetIntArray(const std::string& name, int* values, uint32_t count)
+	{
+		HZ_PROFILE_FUNCTION();
+		UploadUniformIntArray(GetUniformHandle(name), values, count);
+	}
+
+	// the handle overloads are meant for hot loops, so they are not profiled
+
+	void OpenGLShader::SetMat4(UniformHandle handle, const glm::mat4& value)
+	{
+		UploadUniformMat4(handle, value);
+	}
+
+	void OpenGLShader::SetFloat4(UniformHandle handle, const glm::vec4& value)
+	{
+		UploadUniformFloat4(handle, value);
+	}
+
+	void OpenGLShader::SetFloat3(UniformHandle handle, const glm::vec3& value)
+	{
+		UploadUniformFloat3(handle, value);
+	}
+
+	void OpenGLShader::SetFloat(UniformHandle handle, float value)
+	{
+		UploadUniformFloat(handle, value);
+	}
+
+	void OpenGLShader::SetInt(UniformHandle handle, int value)
+	{
+		UploadUniformInt(handle, value);
+	}
+
+	void OpenGLShader::SetIntArray(UniformHandle handle, int* values, uint32_t count)
+	{
+		UploadUniformIntArray(handle, values, count);
 	}
 
 	/////////////////////////////////////////////////////////////////////////////////////
 	/// Upload Uniforms /////////////////////////////////////////////////////////////////
 	/////////////////////////////////////////////////////////////////////////////////////
 
-	void OpenGLShader::UploadUniformMat4(const std::string& name, const glm::mat4& matrix)
+	void OpenGLShader::UploadUniformMat4(int32_t location, const glm::mat4& matrix)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+		RenderThread::Submit([location, matrix]() { glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix)); });
 	}
 
-	void OpenGLShader::UploadUniformMat3(const std::string& name, const glm::mat3& matrix)
+	void OpenGLShader::UploadUniformMat3(int32_t location, const glm::mat3& matrix)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+		RenderThread::Submit([location, matrix]() { glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(matrix)); });
 	}
 
-	void OpenGLShader::UploadUniformFloat4(const std::string& name, const glm::vec4& vector)
+	void OpenGLShader::UploadUniformFloat4(int32_t location, const glm::vec4& vector)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniform4f(location, vector.x, vector.y, vector.z, vector.w);
+		RenderThread::Submit([location, vector]() { glUniform4f(location, vector.x, vector.y, vector.z, vector.w); });
 	}
 
-	void OpenGLShader::UploadUniformFloat3(const std::string& name, const glm::vec3& vector)
+	void OpenGLShader::UploadUniformFloat3(int32_t location, const glm::vec3& vector)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniform3f(location, vector.x, vector.y, vector.z);
+		RenderThread::Submit([location, vector]() { glUniform3f(location, vector.x, vector.y, vector.z); });
 	}
 
-	void OpenGLShader::UploadUniformFloat2(const std::string& name, const glm::vec2& vector)
+	void OpenGLShader::UploadUniformFloat2(int32_t location, const glm::vec2& vector)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniform2f(location, vector.x, vector.y);
+		RenderThread::Submit([location, vector]() { glUniform2f(location, vector.x, vector.y); });
 	}
 
-	void OpenGLShader::UploadUniformFloat(const std::string& name, float value)
+	void OpenGLShader::UploadUniformFloat(int32_t location, float value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniform1f(location, value);
+		RenderThread::Submit([location, value]() { glUniform1f(location, value); });
 	}
 
-	void OpenGLShader::UploadUniformInt4(const std::string& name, const glm::ivec4& vector)
+	void OpenGLShader::UploadUniformInt4(int32_t location, const glm::ivec4& vector)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniform4i(location, vector.x, vector.y, vector.z, vector.w);
+		RenderThread::Submit([location, vector]() { glUniform4i(location, vector.x, vector.y, vector.z, vector.w); });
 	}
 
-	void OpenGLShader::UploadUniformInt3(const std::string& name, const glm::ivec3& vector)
+	void OpenGLShader::UploadUniformInt3(int32_t location, const glm::ivec3& vector)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniform3i(location, vector.x, vector.y, vector.z);
+		RenderThread::Submit([location, vector]() { glUniform3i(location, vector.x, vector.y, vector.z); });
 	}
 
-	void OpenGLShader::UploadUniformInt2(const std::string& name, const glm::ivec2& vector)
+	void OpenGLShader::UploadUniformInt2(int32_t location, const glm::ivec2& vector)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniform2i(location, vector.x, vector.y);
+		RenderThread::Submit([location, vector]() { glUniform2i(location, vector.x, vector.y); });
 	}
 
-	void OpenGLShader::UploadUniformInt(const std::string& name, int value)
+	void OpenGLShader::UploadUniformInt(int32_t location, int value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniform1i(location, value);
+		RenderThread::Submit([location, value]() { glUniform1i(location, value); });
+	}
 
+	void OpenGLShader::UploadUniformIntArray(int32_t location, int* values, uint32_t count)
+	{
+		auto commandValues = (const int*)RenderThread::CopyCommandData(values, count * sizeof(int));
+		RenderThread::Submit([location, commandValues, count]() { glUniform1iv(location, count, commandValues); });
 	}
 
-	void OpenGLShader::UploadUniformBool(const std::string& name, bool value)
+	void OpenGLShader::UploadUniformBool(int32_t location, bool value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniform1i(location, (int)value);
+		RenderThread::Submit([location, value]() { glUniform1i(location, (int)value); });
 	}
 }
\ No newline at end of file
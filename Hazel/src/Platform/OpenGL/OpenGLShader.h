@@ -26,6 +26,17 @@ namespace Hazel {
 		virtual void SetMat4(const std::string& name, const glm::mat4& value) override;
 
 		virtual void SetInt(const std::string& name, int value) override;
+		virtual void SetIntArray(const std::string& name, int* values, uint32_t count) override;
+
+		virtual UniformHandle GetUniformHandle(const std::string& name) const override;
+
+		virtual void SetFloat4(UniformHandle handle, const glm::vec4& value) override;
+		virtual void SetFloat3(UniformHandle handle, const glm::vec3& value) override;
+		virtual void SetFloat(UniformHandle handle, float value) override;
+		virtual void SetMat4(UniformHandle handle, const glm::mat4& value) override;
+
+		virtual void SetInt(UniformHandle handle, int value) override;
+		virtual void SetIntArray(UniformHandle handle, int* values, uint32_t count) override;
 		////////////////////////
 		////////////////////////
 
@@ -33,27 +44,38 @@ namespace Hazel {
 
 	private:
 		// OpenGL impl of Set methods
-		virtual void UploadUniformMat4(const std::string& name, const glm::mat4& matrix);
-		virtual void UploadUniformMat3(const std::string& name, const glm::mat3& matrix);
+		virtual void UploadUniformMat4(int32_t location, const glm::mat4& matrix);
+		virtual void UploadUniformMat3(int32_t location, const glm::mat3& matrix);
 
-		virtual void UploadUniformFloat4(const std::string& name, const glm::vec4& vector);
-		virtual void UploadUniformFloat3(const std::string& name, const glm::vec3& vector);
-		virtual void UploadUniformFloat2(const std::string& name, const glm::vec2& vector);
-		virtual void UploadUniformFloat(const std::string& name, float value);
+		virtual void UploadUniformFloat4(int32_t location, const glm::vec4& vector);
+		virtual void UploadUniformFloat3(int32_t location, const glm::vec3& vector);
+		virtual void UploadUniformFloat2(int32_t location, const glm::vec2& vector);
+		virtual void UploadUniformFloat(int32_t location, float value);
 
-		virtual void UploadUniformInt4(const std::string& name, const glm::ivec4& vector);
-		virtual void UploadUniformInt3(const std::string& name, const glm::ivec3& vector);
-		virtual void UploadUniformInt2(const std::string& name, const glm::ivec2& vector);
-		virtual void UploadUniformInt(const std::string& name, int value);
+		virtual void UploadUniformInt4(int32_t location, const glm::ivec4& vector);
+		virtual void UploadUniformInt3(int32_t location, const glm::ivec3& vector);
+		virtual void UploadUniformInt2(int32_t location, const glm::ivec2& vector);
+		virtual void UploadUniformInt(int32_t location, int value);
+		virtual void UploadUniformIntArray(int32_t location, int* values, uint32_t count);
 
-		virtual void UploadUniformBool(const std::string& name, bool value);
+		virtual void UploadUniformBool(int32_t location, bool value);
 
 		std::string ReadFile(const std::string& filepath);
 		std::unordered_map<GLenum, std::string> PreProcess(const std::string& source);
+		void CreateProgram(const std::unordered_map<GLenum, std::string>& shaderSources);
 		void Compile(const std::unordered_map<GLenum, std::string>& shaderSources);
+		void Reflect();
+
+		// Program binary cache, keyed by the preprocessed sources and the driver
+		std::string GetCachePath(const std::unordered_map<GLenum, std::string>& shaderSources) const;
+		bool LoadProgramBinary(const std::string& cachePath);
+		void SaveProgramBinary(const std::string& cachePath);
 	private:
-		uint32_t m_RendererID;
+		uint32_t m_RendererID = 0;
 		std::string m_Name;
+
+		// uniform locations queried once after linking, keyed by the FNV-1a hash of their name
+		std::unordered_map<uint32_t, int32_t> m_UniformLocations;
 	};
 
 }
\ No newline at end of file
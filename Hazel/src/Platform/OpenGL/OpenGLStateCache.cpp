@@ -0,0 +1,98 @@
+#include "hzpch.h"
+#include "OpenGLStateCache.h"
+
+#include "Hazel/Renderer/RendererAPI.h"
+
+#include <glad/glad.h>
+
+namespace Hazel {
+
+	struct OpenGLStateCacheData
+	{
+		// nothing is assumed about the state before the first call
+		bool ProgramKnown = false;
+		uint32_t Program = 0;
+
+		// handles rather than names, the name may not exist yet while recording. Holding on to
+		// them also keeps a new object from being mistaken for a deleted one at the same address
+		bool VertexArrayKnown = false;
+		RendererHandle VertexArray;
+
+		std::array<bool, OpenGLStateCache::MaxTextureUnits> TexturesKnown = {};
+		std::array<RendererHandle, OpenGLStateCache::MaxTextureUnits> Textures;
+
+		bool DepthFuncKnown = false;
+		uint32_t DepthFunc = 0;
+
+		bool ViewportKnown = false;
+		glm::uvec4 Viewport = {};
+	};
+
+	static OpenGLStateCacheData s_Data;
+
+	// true when the call has to be made
+	template<typename T>
+	static bool Update(bool& known, T& current, const T& value)
+	{
+		if (known && current == value)
+		{
+			RendererAPI::GetCounters().SkippedStateChanges++;
+			return false;
+		}
+
+		known = true;
+		current = value;
+		RendererAPI::GetCounters().StateChanges++;
+		return true;
+	}
+
+	void OpenGLStateCache::UseProgram(uint32_t program)
+	{
+		if (Update(s_Data.ProgramKnown, s_Data.Program, program))
+			RenderThread::Submit([program]() { glUseProgram(program); });
+	}
+
+	void OpenGLStateCache::BindVertexArray(const RendererHandle& vertexArray)
+	{
+		if (Update(s_Data.VertexArrayKnown, s_Data.VertexArray, vertexArray))
+			RenderThread::Submit([vertexArray]() { glBindVertexArray(vertexArray ? (GLuint)*vertexArray : 0); });
+	}
+
+	void OpenGLStateCache::BindTextureUnit(uint32_t slot, const RendererHandle& texture)
+	{
+		if (slot >= MaxTextureUnits)
+			RendererAPI::GetCounters().StateChanges++;
+		else if (!Update(s_Data.TexturesKnown[slot], s_Data.Textures[slot], texture))
+			return;
+
+		RenderThread::Submit([slot, texture]() { glBindTextureUnit(slot, texture ? (GLuint)*texture : 0); });
+	}
+
+	void OpenGLStateCache::DepthFunc(uint32_t func)
+	{
+		if (Update(s_Data.DepthFuncKnown, s_Data.DepthFunc, func))
+			RenderThread::Submit([func]() { glDepthFunc(func); });
+	}
+
+	void OpenGLStateCache::Viewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		if (Update(s_Data.ViewportKnown, s_Data.Viewport, glm::uvec4(x, y, width, height)))
+			RenderThread::Submit([x, y, width, height]() { glViewport(x, y, width, height); });
+	}
+
+	void OpenGLStateCache::ForgetProgram(uint32_t program)
+	{
+		if (s_Data.Program == program)
+			s_Data.ProgramKnown = false;
+	}
+
+	void OpenGLStateCache::ForgetTexture(const RendererHandle& texture)
+	{
+		for (uint32_t slot = 0; slot < MaxTextureUnits; slot++)
+		{
+			if (s_Data.Textures[slot] == texture)
+				s_Data.TexturesKnown[slot] = false;
+		}
+	}
+
+}
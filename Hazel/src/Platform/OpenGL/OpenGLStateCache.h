@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Hazel/Renderer/RenderThread.h"
+
+namespace Hazel {
+
+	// Remembers the bindings the recorded GL calls leave behind and drops the calls that would
+	// not change anything, like binding the shader that is already in use. Commands run in
+	// submission order, so the state seen while recording is the state the GL calls will find.
+	// Every change of the tracked state has to go through here, otherwise the cache goes stale.
+	// Skipped calls are counted in RendererAPI::Counters::SkippedStateChanges.
+	class OpenGLStateCache
+	{
+	public:
+		// units past this are not cached, every bind goes through
+		static constexpr uint32_t MaxTextureUnits = 32;
+
+		static void UseProgram(uint32_t program);
+		// an empty handle binds 0
+		static void BindVertexArray(const RendererHandle& vertexArray);
+		static void BindTextureUnit(uint32_t slot, const RendererHandle& texture);
+		static void DepthFunc(uint32_t func);
+		static void Viewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+
+		// the name was deleted or now stands for a new GL object, the next bind is not redundant
+		static void ForgetProgram(uint32_t program);
+		static void ForgetTexture(const RendererHandle& texture);
+	};
+
+}
@@ -1,5 +1,10 @@
 #include "hzpch.h"
 #include "OpenGLTexture.h"
+#include "OpenGLStateCache.h"
+#include "Hazel/Renderer/RendererAPI.h"
+#include "Hazel/Renderer/RenderThread.h"
+
+#include "Hazel/Core/JobSystem.h"
 
 #include "stb_image.h"
 
@@ -9,25 +14,39 @@ namespace Hazel {
 	/// OpenGLTexture2D /////////////////////////////////////////////
 	/////////////////////////////////////////////////////////////////
 	
+	static void DeleteTexture(const RendererHandle& handle)
+	{
+		RenderThread::Submit([handle]()
+		{
+			GLuint id = *handle;
+			glDeleteTextures(1, &id);
+		});
+	}
+
 	OpenGLTexture2D::OpenGLTexture2D(uint32_t width, uint32_t height)
-		:m_Width(width), m_Height(height)
+		:m_Width(width), m_Height(height), m_RendererID(CreateRendererHandle())
 	{
 		HZ_PROFILE_FUNCTION();
 		m_InternalFormat = GL_RGBA8, m_DataFormat = GL_RGBA;
 
-		// allocate memory on GPU
-		glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-		glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Width, m_Height);
+		RenderThread::Submit([id = m_RendererID, width, height, internalFormat = m_InternalFormat]()
+		{
+			// allocate memory on GPU
+			GLuint texture = 0;
+			glCreateTextures(GL_TEXTURE_2D, 1, &texture);
+			glTextureStorage2D(texture, 1, internalFormat, width, height);
 
-		// assign parameters for scaling
-		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+			// assign parameters for scaling
+			glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+			glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+			glTextureParameteri(texture, GL_TEXTURE_WRAP_S, GL_REPEAT);
+			glTextureParameteri(texture, GL_TEXTURE_WRAP_T, GL_REPEAT);
+			*id = texture;
+		});
 	}
 
 	OpenGLTexture2D::OpenGLTexture2D(const std::string& path)
-		: m_Path(path)
+		: m_Path(path), m_RendererID(CreateRendererHandle())
 	{
 		HZ_PROFILE_FUNCTION();
 		int width, height, channels;
@@ -38,6 +57,15 @@ namespace Hazel {
 			data = stbi_load(path.c_str(), &width, &height, &channels, 0);
 		}
 		HZ_CORE_ASSERT(data, "Failed to load image!");
+
+		SetImage(width, height, channels, data);
+
+		stbi_image_free(data);
+	}
+
+	void OpenGLTexture2D::SetImage(uint32_t width, uint32_t height, uint32_t channels, const void* pixels)
+	{
+		HZ_PROFILE_FUNCTION();
 		m_Width = width;
 		m_Height = height;
 
@@ -60,26 +88,38 @@ namespace Hazel {
 		
 		HZ_CORE_ASSERT(internalFormat & dataFormat, "Format not supported!");
 
-		// allocate memory on GPU
-		glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-		glTextureStorage2D(m_RendererID, 1, internalFormat, m_Width, m_Height);
+		size_t size = (size_t)width * height * channels;
+		RendererAPI::GetCounters().UploadedBytes += (uint32_t)size;
+		const void* commandPixels = RenderThread::CopyCommandData(pixels, size);
+		// the texture is created anew below, with a name no unit has bound yet
+		OpenGLStateCache::ForgetTexture(m_RendererID);
+		RenderThread::Submit([id = m_RendererID, width, height, internalFormat, dataFormat, commandPixels]()
+		{
+			// immutable storage cannot be resized, start over with a new texture
+			GLuint texture = *id;
+			if (texture)
+				glDeleteTextures(1, &texture);
 
-		// assign parameters for scaling
-		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+			// allocate memory on GPU
+			glCreateTextures(GL_TEXTURE_2D, 1, &texture);
+			glTextureStorage2D(texture, 1, internalFormat, width, height);
 
-		// upload the texture
-		glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, dataFormat, GL_UNSIGNED_BYTE, data);
+			// assign parameters for scaling
+			glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+			glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+			glTextureParameteri(texture, GL_TEXTURE_WRAP_S, GL_REPEAT);
+			glTextureParameteri(texture, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
-		stbi_image_free(data);
+			// upload the texture
+			glTextureSubImage2D(texture, 0, 0, 0, width, height, dataFormat, GL_UNSIGNED_BYTE, commandPixels);
+			*id = texture;
+		});
 	}
 
 	OpenGLTexture2D::~OpenGLTexture2D()
 	{
 		HZ_PROFILE_FUNCTION();
-		glDeleteTextures(1, &m_RendererID);
+		DeleteTexture(m_RendererID);
 	}
 
 	void OpenGLTexture2D::SetData(void* data, uint32_t size)
@@ -87,13 +127,18 @@ namespace Hazel {
 		HZ_PROFILE_FUNCTION();
 		// size has to equal width * height * bytes per pixel
 		HZ_CORE_ASSERT(size == m_Width * m_Height * (m_DataFormat == GL_RGBA ? 4 : 3), "Data must be entire texture!");
-		glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, data);
+		RendererAPI::GetCounters().UploadedBytes += size;
+		const void* commandData = RenderThread::CopyCommandData(data, size);
+		RenderThread::Submit([id = m_RendererID, width = m_Width, height = m_Height, dataFormat = m_DataFormat, commandData]()
+		{
+			glTextureSubImage2D(*id, 0, 0, 0, width, height, dataFormat, GL_UNSIGNED_BYTE, commandData);
+		});
 	}
 
 	void OpenGLTexture2D::Bind(uint32_t slot) const
 	{
 		HZ_PROFILE_FUNCTION();
-		glBindTextureUnit(slot, m_RendererID);
+		OpenGLStateCache::BindTextureUnit(slot, m_RendererID);
 	}
 
 	/////////////////////////////////////////////////////////////////
@@ -101,56 +146,131 @@ namespace Hazel {
 	/////////////////////////////////////////////////////////////////
 	
 	OpenGLTextureCubeMap::OpenGLTextureCubeMap(const std::vector<std::string>& filepaths)
-		:m_Width(0), m_Height(0)
+		:m_Width(0), m_Height(0), m_RendererID(CreateRendererHandle())
 	{
+		HZ_PROFILE_FUNCTION();
 		HZ_CORE_ASSERT(filepaths.size() == 6, "Exactly 6 filepaths should be provided!");
 
-		stbi_set_flip_vertically_on_load(false);
+		struct Face
+		{
+			int Width = 0, Height = 0, Channels = 0;
+			stbi_uc* Data = nullptr;
+			const char* FailureReason = nullptr;
+		};
+		std::array<Face, 6> faces;
 
-		glCreateTextures(GL_TEXTURE_CUBE_MAP, 1, &m_RendererID);
-		glBindTexture(GL_TEXTURE_CUBE_MAP, m_RendererID);
+		// decode all faces at once, one job per face
+		{
+			HZ_PROFILE_SCOPE("Decode faces - OpenGLTextureCubeMap::OpenGLTextureCubeMap");
+			JobSystem::ParallelFor(6, 1, [&faces, &filepaths](uint32_t begin, uint32_t end)
+			{
+				// one entry per face, named after its file
+				HZ_PROFILE_SCOPE_DYNAMIC(filepaths[begin].c_str());
+				Face& face = faces[begin];
+				stbi_set_flip_vertically_on_load_thread(false);
+				face.Data = stbi_load(filepaths[begin].c_str(), &face.Width, &face.Height, &face.Channels, 0);
+				if (!face.Data)
+					face.FailureReason = stbi_failure_reason();
+			});
+		}
+
+		// every face has to decode and match the first one before anything reaches the GPU
+		bool valid = true;
+		for (size_t i = 0; i < 6; i++)
+		{
+			const Face& face = faces[i];
+			if (!face.Data)
+			{
+				HZ_CORE_ERROR("Failed to load cube map face '{0}': {1}", filepaths[i], face.FailureReason);
+				valid = false;
+			}
+			else if (face.Width != face.Height)
+			{
+				HZ_CORE_ERROR("Cube map face '{0}' is not square ({1}x{2})", filepaths[i], face.Width, face.Height);
+				valid = false;
+			}
+			else if (face.Width != faces[0].Width || face.Channels != faces[0].Channels)
+			{
+				HZ_CORE_ERROR("Cube map face '{0}' ({1}x{2}, {3} channels) does not match '{4}' ({5}x{6}, {7} channels)",
+					filepaths[i], face.Width, face.Height, face.Channels,
+					filepaths[0], faces[0].Width, faces[0].Height, faces[0].Channels);
+				valid = false;
+			}
+		}
 
-		int width, height, channels;
 		GLenum internalFormat = 0, dataFormat = 0;
+		if (faces[0].Channels == 4)
+		{
+			internalFormat = GL_RGBA8;
+			dataFormat = GL_RGBA;
+		}
+
+		else if (faces[0].Channels == 3)
+		{
+			internalFormat = GL_RGB8;
+			dataFormat = GL_RGB;
+		}
 
-		for (unsigned int i = 0; i < 6; i++)
+		if (valid && !(internalFormat & dataFormat))
 		{
-			stbi_uc* data = nullptr;
-			data = stbi_load(filepaths[i].c_str(), &width, &height, &channels, 0);
+			HZ_CORE_ERROR("Cube map face '{0}' has an unsupported channel count ({1})", filepaths[0], faces[0].Channels);
+			valid = false;
+		}
+
+		HZ_CORE_ASSERT(valid, "Invalid cube map faces!");
 
-			HZ_CORE_ASSERT(data, "Failed to load image!");
-			if (channels == 4)
+		if (valid)
+		{
+			m_Width = faces[0].Width;
+			m_Height = faces[0].Height;
+			RendererAPI::GetCounters().UploadedBytes += 6 * m_Width * m_Height * faces[0].Channels;
+		}
+		else
+		{
+			// a 1x1 cube map without contents, so the texture is still complete
+			for (Face& face : faces)
 			{
-				internalFormat = GL_RGBA8;
-				dataFormat = GL_RGBA;
+				stbi_image_free(face.Data);
+				face.Data = nullptr;
 			}
+			m_Width = m_Height = 1;
+			internalFormat = GL_RGBA8;
+			dataFormat = GL_RGBA;
+		}
+
+		// the decoded faces belong to the command from here on, it frees them once uploaded
+		RenderThread::Submit([id = m_RendererID, faces, valid, size = m_Width, internalFormat, dataFormat]()
+		{
+			GLuint texture = 0;
+			glCreateTextures(GL_TEXTURE_CUBE_MAP, 1, &texture);
+			glTextureStorage2D(texture, 1, internalFormat, size, size);
 
-			else if (channels == 3)
+			// faces are layers of the cube map, in +X -X +Y -Y +Z -Z order
+			for (int i = 0; i < 6; i++)
 			{
-				internalFormat = GL_RGB16;
-				dataFormat = GL_RGB;
+				if (valid)
+					glTextureSubImage3D(texture, 0, 0, 0, i, size, size, 1, dataFormat, GL_UNSIGNED_BYTE, faces[i].Data);
+				stbi_image_free(faces[i].Data);
 			}
 
-			glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i,
-				0, internalFormat, width, height, 0, dataFormat, GL_UNSIGNED_BYTE, data);
-			stbi_image_free(data);
-		}
-
-		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+			glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glTextureParameteri(texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTextureParameteri(texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+			glTextureParameteri(texture, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+			*id = texture;
+		});
 	}
 
 	OpenGLTextureCubeMap::~OpenGLTextureCubeMap()
 	{
-		glDeleteTextures(1, &m_RendererID);
+		DeleteTexture(m_RendererID);
 	}
 
 	void OpenGLTextureCubeMap::Bind(uint32_t slot) const
 	{
-		glBindTexture(GL_TEXTURE_CUBE_MAP, m_RendererID);
+		HZ_PROFILE_FUNCTION();
+		OpenGLStateCache::BindTextureUnit(slot, m_RendererID);
 	}
 
 	void OpenGLTextureCubeMap::SetData(void* data, uint32_t size)
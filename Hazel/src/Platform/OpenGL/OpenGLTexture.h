@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Hazel/Renderer/Texture.h"
+#include "Hazel/Renderer/RenderThread.h"
 #include <glad/glad.h>
 
 namespace Hazel {
@@ -14,14 +15,16 @@ namespace Hazel {
 
 		inline virtual uint32_t GetWidth() const override { return m_Width; }
 		inline virtual uint32_t GetHeight() const override { return m_Height; }
+		inline virtual uint32_t GetRendererID() const override { return *m_RendererID; }
 		virtual void SetData(void* data, uint32_t size) override;
 
 		virtual void Bind(uint32_t slot = 0) const override;
-
+	protected:
+		virtual void SetImage(uint32_t width, uint32_t height, uint32_t channels, const void* pixels) override;
 	private:
 		std::string m_Path;
 		uint32_t m_Width, m_Height;
-		uint32_t m_RendererID;
+		RendererHandle m_RendererID;
 
 		GLenum m_InternalFormat;
 		GLenum m_DataFormat;
@@ -35,12 +38,13 @@ namespace Hazel {
 
 		inline virtual uint32_t GetWidth() const override { return m_Width; }
 		inline virtual uint32_t GetHeight() const override { return m_Height; }
+		inline virtual uint32_t GetRendererID() const override { return *m_RendererID; }
 		virtual void SetData(void* data, uint32_t size) override;
 
 		virtual void Bind(uint32_t slot = 0) const override;
 	private:
 		std::string m_Path;
 		uint32_t m_Width, m_Height;
-		uint32_t m_RendererID;
+		RendererHandle m_RendererID;
 	};
 }
\ No newline at end of file
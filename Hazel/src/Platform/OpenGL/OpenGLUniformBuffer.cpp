@@ -0,0 +1,42 @@
+#include "hzpch.h"
+#include "OpenGLUniformBuffer.h"
+
+#include "Hazel/Renderer/RendererAPI.h"
+
+#include <glad/glad.h>
+
+namespace Hazel {
+
+	OpenGLUniformBuffer::OpenGLUniformBuffer(uint32_t size, uint32_t binding)
+		: m_RendererID(CreateRendererHandle())
+	{
+		HZ_PROFILE_FUNCTION();
+		RenderThread::Submit([id = m_RendererID, size, binding]()
+		{
+			GLuint buffer = 0;
+			glCreateBuffers(1, &buffer);
+			glNamedBufferData(buffer, size, nullptr, GL_DYNAMIC_DRAW);
+			glBindBufferBase(GL_UNIFORM_BUFFER, binding, buffer);
+			*id = buffer;
+		});
+	}
+
+	OpenGLUniformBuffer::~OpenGLUniformBuffer()
+	{
+		HZ_PROFILE_FUNCTION();
+		RenderThread::Submit([id = m_RendererID]()
+		{
+			GLuint buffer = *id;
+			glDeleteBuffers(1, &buffer);
+		});
+	}
+
+	void OpenGLUniformBuffer::SetData(const void* data, uint32_t size, uint32_t offset)
+	{
+		HZ_PROFILE_FUNCTION();
+		RendererAPI::GetCounters().UploadedBytes += size;
+		const void* commandData = RenderThread::CopyCommandData(data, size);
+		RenderThread::Submit([id = m_RendererID, commandData, size, offset]() { glNamedBufferSubData(*id, offset, size, commandData); });
+	}
+
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "Hazel/Renderer/UniformBuffer.h"
+#include "Hazel/Renderer/RenderThread.h"
+
+namespace Hazel {
+
+	class OpenGLUniformBuffer : public UniformBuffer
+	{
+	public:
+		OpenGLUniformBuffer(uint32_t size, uint32_t binding);
+		virtual ~OpenGLUniformBuffer();
+
+		virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) override;
+	private:
+		RendererHandle m_RendererID;
+	};
+
+}
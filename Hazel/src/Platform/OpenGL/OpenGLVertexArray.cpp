@@ -1,5 +1,6 @@
 #include "hzpch.h"
 #include "OpenGLVertexArray.h"
+#include "OpenGLStateCache.h"
 
 #include <glad/glad.h>
 
@@ -29,27 +30,37 @@ namespace Hazel {
 	}
 
 	OpenGLVertexArray::OpenGLVertexArray()
+		: m_RendererID(CreateRendererHandle())
 	{
 		HZ_PROFILE_FUNCTION();
-		glCreateVertexArrays(1, &m_RendererID);
+		RenderThread::Submit([id = m_RendererID]()
+		{
+			GLuint vertexArray = 0;
+			glCreateVertexArrays(1, &vertexArray);
+			*id = vertexArray;
+		});
 	}
 
 	OpenGLVertexArray::~OpenGLVertexArray()
 	{
 		HZ_PROFILE_FUNCTION();
-		glDeleteVertexArrays(1, &m_RendererID);
+		RenderThread::Submit([id = m_RendererID]()
+		{
+			GLuint vertexArray = *id;
+			glDeleteVertexArrays(1, &vertexArray);
+		});
 	}
 
 	void OpenGLVertexArray::Bind() const
 	{
 		HZ_PROFILE_FUNCTION();
-		glBindVertexArray(m_RendererID);
+		OpenGLStateCache::BindVertexArray(m_RendererID);
 	}
 
 	void OpenGLVertexArray::Unbind() const
 	{
 		HZ_PROFILE_FUNCTION();
-		glBindVertexArray(0);
+		OpenGLStateCache::BindVertexArray(nullptr);
 	}
 
 	void OpenGLVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer)
@@ -57,23 +68,33 @@ namespace Hazel {
 		HZ_PROFILE_FUNCTION();
 		HZ_CORE_ASSERT(vertexBuffer->GetLayout().GetElements().size(), "Vertex Buffer has not layout!");
 
-		glBindVertexArray(m_RendererID);
+		OpenGLStateCache::BindVertexArray(m_RendererID);
 		vertexBuffer->Bind();
 
-		const auto& layout = vertexBuffer->GetLayout();
-		for (const auto& element : layout)
+		// the layout is copied into the command, it may change before the command runs
+		RenderThread::Submit([layout = vertexBuffer->GetLayout(), index = m_VertexBufferIndex]() mutable
 		{
-			glEnableVertexAttribArray(m_VertexBufferIndex);
-			glVertexAttribPointer(
-				m_VertexBufferIndex,
-				element.GetComponentCount(),
-				ShaderDataTypeToOpenGLBaseType(element.Type),
-				element.Normalized ? GL_TRUE : GL_FALSE,
-				layout.GetStride(),
-				(const void*)(intptr_t)element.Offset
-			);
-			m_VertexBufferIndex++;
-		}
+			for (const auto& element : layout)
+			{
+				// attributes have at most 4 components, matrices are passed one column per location
+				uint32_t columns = element.GetLocationCount();
+				uint32_t components = element.GetComponentCount() / columns;
+				GLenum type = ShaderDataTypeToOpenGLBaseType(element.Type);
+				for (uint32_t column = 0; column < columns; column++)
+				{
+					const void* offset = (const void*)(intptr_t)(element.Offset + column * components * sizeof(float));
+					glEnableVertexAttribArray(index);
+					// integers would be converted to float otherwise
+					if (type == GL_INT)
+						glVertexAttribIPointer(index, components, type, layout.GetStride(), offset);
+					else
+						glVertexAttribPointer(index, components, type, element.Normalized ? GL_TRUE : GL_FALSE, layout.GetStride(), offset);
+					glVertexAttribDivisor(index, element.PerInstance ? 1 : 0);
+					index++;
+				}
+			}
+		});
+		m_VertexBufferIndex += vertexBuffer->GetLayout().GetLocationCount();
 
 		m_VertexBuffers.push_back(vertexBuffer);
 	}
@@ -81,7 +102,7 @@ namespace Hazel {
 	void OpenGLVertexArray::SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer)
 	{
 		HZ_PROFILE_FUNCTION();
-		glBindVertexArray(m_RendererID);
+		OpenGLStateCache::BindVertexArray(m_RendererID);
 		indexBuffer->Bind();
 
 		m_IndexBuffer = indexBuffer;
@@ -1,5 +1,6 @@
 #pragma once
 #include "Hazel/Renderer/VertexArray.h"
+#include "Hazel/Renderer/RenderThread.h"
 
 namespace Hazel {
 
@@ -18,7 +19,7 @@ namespace Hazel {
 		virtual const std::vector<Ref<VertexBuffer>>& GetVertexBuffers() const override { return m_VertexBuffers; }
 		virtual const Ref<IndexBuffer>& GetIndexBuffer() const override { return m_IndexBuffer; }
 	private:
-		uint32_t m_RendererID;
+		RendererHandle m_RendererID;
 		uint32_t m_VertexBufferIndex = 0;
 		std::vector<Ref<VertexBuffer>> m_VertexBuffers;
 		Ref<IndexBuffer> m_IndexBuffer;
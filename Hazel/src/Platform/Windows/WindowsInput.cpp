@@ -3,10 +3,21 @@
 
 #include <GLFW/glfw3.h>
 #include "Hazel/Core/Application.h"
+#include "Hazel/Renderer/RendererAPI.h"
+#include "Platform/Null/NullInput.h"
 
 namespace Hazel {
 
-	Input* Input::s_Instance = new WindowsInput();
+	Scope<Input> Input::s_Instance;
+
+	void Input::Init()
+	{
+		// the headless window of the null renderer has nothing to poll
+		if (RendererAPI::GetAPI() == RendererAPI::API::Null)
+			s_Instance = CreateScope<NullInput>();
+		else
+			s_Instance = CreateScope<WindowsInput>();
+	}
 
 	bool WindowsInput::IsKeyPressedImpl(int keycode)
 	{
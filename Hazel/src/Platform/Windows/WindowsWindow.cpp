@@ -4,6 +4,9 @@
 #include "Hazel/Events/KeyEvent.h"
 #include "Hazel/Events/MouseEvent.h"
 #include "Hazel/Events/ApplicationEvent.h"
+#include "Hazel/Renderer/RenderThread.h"
+#include "Hazel/Renderer/RendererAPI.h"
+#include "Platform/Null/NullWindow.h"
 
 namespace Hazel {
 
@@ -16,6 +19,9 @@ namespace Hazel {
 
 	Window* Window::Create(const WindowProps& props)
 	{
+		// the null renderer runs without a desktop window
+		if (RendererAPI::GetAPI() == RendererAPI::API::Null)
+			return new NullWindow(props);
 		return new WindowsWindow(props);
 	}
 
@@ -170,13 +176,14 @@ namespace Hazel {
 		HZ_PROFILE_FUNCTION();
 
 		glfwPollEvents();
-		m_Context->SwapBuffers();
+		RenderThread::Submit([context = m_Context]() { context->SwapBuffers(); });
 	}
 
 	void WindowsWindow::SetVSync(bool enable)
 	{
 		HZ_PROFILE_FUNCTION();
-		glfwSwapInterval(enable ? 1 : 0);
+		// the swap interval belongs to the context, set it where the context is current
+		RenderThread::Submit([enable]() { glfwSwapInterval(enable ? 1 : 0); });
 
 		m_Data.VSync = enable;
 	}
@@ -27,6 +27,7 @@ namespace Hazel {
 		virtual bool IsCursorEnabled() const override;
 
 		inline virtual void* GetNativeWindow() const { return m_Window; };
+		inline virtual GraphicsContext& GetContext() const override { return *m_Context; }
 	private:
 		virtual void Init(const WindowProps& props);
 		virtual void Shutdown();
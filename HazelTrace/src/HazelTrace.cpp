@@ -0,0 +1,242 @@
+// HazelTrace: converts binary Instrumentor traces (.hztrace) to Chrome tracing JSON
+// or prints per-scope statistics.
+//
+//   HazelTrace json  <trace.hztrace> [out.json]
+//   HazelTrace stats <trace.hztrace>
+
+#include "Hazel/Debug/TraceFormat.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace Hazel;
+
+struct TraceEvent
+{
+	uint32_t ThreadIndex;
+	uint32_t NameID;
+	int64_t Start, Duration; // nanoseconds
+};
+
+struct Trace
+{
+	std::string SessionName;
+	std::unordered_map<uint32_t, std::string> Names;
+	std::vector<TraceEvent> Events;
+};
+
+// far more threads than a session ever runs, a larger index means the record is corrupt
+static constexpr uint64_t MaxThreadIndex = 65535;
+
+static bool LoadTrace(const std::string& filepath, Trace& trace)
+{
+	std::ifstream in(filepath, std::ios::in | std::ios::binary);
+	if (!in)
+	{
+		std::cerr << "Could not open '" << filepath << "'\n";
+		return false;
+	}
+	std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+	const uint8_t* it = data.data();
+	const uint8_t* end = it + data.size();
+	uint64_t version;
+	if (data.size() < sizeof(TraceFormat::Magic) || memcmp(it, TraceFormat::Magic, sizeof(TraceFormat::Magic)) != 0)
+	{
+		std::cerr << "'" << filepath << "' is not a Hazel trace\n";
+		return false;
+	}
+	it += sizeof(TraceFormat::Magic);
+	if (!TraceFormat::ReadVarint(it, end, version) || version != TraceFormat::Version)
+	{
+		std::cerr << "'" << filepath << "' has unsupported version " << version << "\n";
+		return false;
+	}
+	if (!TraceFormat::ReadString(it, end, trace.SessionName))
+	{
+		std::cerr << "'" << filepath << "' is truncated\n";
+		return false;
+	}
+
+	std::vector<int64_t> lastStart;
+	while (it != end)
+	{
+		TraceFormat::RecordType type = (TraceFormat::RecordType)*it++;
+		bool ok = false;
+		switch (type)
+		{
+		case TraceFormat::RecordType::Name:
+		{
+			uint64_t id;
+			std::string name;
+			ok = TraceFormat::ReadVarint(it, end, id) && TraceFormat::ReadString(it, end, name);
+			if (ok)
+				trace.Names[(uint32_t)id] = std::move(name);
+			break;
+		}
+		case TraceFormat::RecordType::Event:
+		{
+			uint64_t thread, name, delta, duration;
+			ok = TraceFormat::ReadVarint(it, end, thread) && TraceFormat::ReadVarint(it, end, name)
+				&& TraceFormat::ReadVarint(it, end, delta) && TraceFormat::ReadVarint(it, end, duration)
+				&& thread <= MaxThreadIndex;
+			if (ok)
+			{
+				if (thread >= lastStart.size())
+					lastStart.resize((size_t)thread + 1, 0);
+				lastStart[thread] += TraceFormat::ZigZagDecode(delta);
+				trace.Events.push_back({ (uint32_t)thread, (uint32_t)name, lastStart[thread], (int64_t)duration });
+			}
+			break;
+		}
+		}
+
+		// a session that was cut short may end mid record, keep what was read so far
+		if (!ok)
+		{
+			std::cerr << "Warning: '" << filepath << "' is truncated or corrupt, stopping after " << trace.Events.size() << " events\n";
+			break;
+		}
+	}
+	return true;
+}
+
+static std::string EscapeJson(const std::string& value)
+{
+	std::string result;
+	result.reserve(value.size());
+	for (char c : value)
+	{
+		if (c == '"' || c == '\\')
+		{
+			result += '\\';
+			result += c;
+		}
+		else if ((unsigned char)c < 0x20)
+		{
+			// control characters are not allowed raw in a JSON string
+			char escaped[7];
+			snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned char)c);
+			result += escaped;
+		}
+		else
+			result += c;
+	}
+	return result;
+}
+
+static int WriteJson(const Trace& trace, std::ostream& out)
+{
+	out << std::fixed << std::setprecision(3);
+	out << "{\"otherData\": {\"session\":\"" << EscapeJson(trace.SessionName) << "\"},\"traceEvents\":[";
+
+	std::unordered_map<uint32_t, std::string> escapedNames;
+	for (auto& [id, name] : trace.Names)
+		escapedNames[id] = EscapeJson(name);
+
+	for (size_t i = 0; i < trace.Events.size(); i++)
+	{
+		const TraceEvent& event = trace.Events[i];
+		if (i > 0)
+			out << ",";
+
+		out << "{";
+		out << "\"cat\":\"function\",";
+		out << "\"dur\":" << event.Duration * 0.001 << ',';
+		out << "\"name\":\"" << escapedNames[event.NameID] << "\",";
+		out << "\"ph\":\"X\",";
+		out << "\"pid\":0,";
+		out << "\"tid\":" << event.ThreadIndex << ",";
+		out << "\"ts\":" << event.Start * 0.001;
+		out << "}";
+	}
+	out << "]}";
+	return 0;
+}
+
+static int PrintStats(const Trace& trace)
+{
+	struct ScopeStats
+	{
+		uint32_t NameID;
+		int64_t Total = 0;
+		std::vector<int64_t> Durations;
+	};
+
+	std::unordered_map<uint32_t, ScopeStats> scopes;
+	for (const TraceEvent& event : trace.Events)
+	{
+		ScopeStats& stats = scopes[event.NameID];
+		stats.NameID = event.NameID;
+		stats.Total += event.Duration;
+		stats.Durations.push_back(event.Duration);
+	}
+
+	std::vector<ScopeStats*> sorted;
+	for (auto& [id, stats] : scopes)
+	{
+		std::sort(stats.Durations.begin(), stats.Durations.end());
+		sorted.push_back(&stats);
+	}
+	std::sort(sorted.begin(), sorted.end(), [](const ScopeStats* a, const ScopeStats* b) { return a->Total > b->Total; });
+
+	auto percentile = [](const std::vector<int64_t>& durations, double p)
+	{
+		size_t index = (size_t)(p * (durations.size() - 1) + 0.5);
+		return durations[index] * 1e-3;
+	};
+
+	std::printf("Session '%s', %zu events, %zu scopes\n\n", trace.SessionName.c_str(), trace.Events.size(), sorted.size());
+	std::printf("%10s %12s %10s %10s %10s  %s\n", "count", "total ms", "p50 us", "p99 us", "max us", "scope");
+	for (const ScopeStats* stats : sorted)
+	{
+		auto it = trace.Names.find(stats->NameID);
+		const char* name = it != trace.Names.end() ? it->second.c_str() : "<unknown>";
+		std::printf("%10zu %12.3f %10.2f %10.2f %10.2f  %s\n", stats->Durations.size(), stats->Total * 1e-6,
+			percentile(stats->Durations, 0.50), percentile(stats->Durations, 0.99), stats->Durations.back() * 1e-3, name);
+	}
+	return 0;
+}
+
+static int PrintUsage()
+{
+	std::cerr << "Usage:\n"
+		<< "  HazelTrace json  <trace.hztrace> [out.json]   convert to Chrome tracing JSON (chrome://tracing)\n"
+		<< "  HazelTrace stats <trace.hztrace>              per-scope count, total, p50, p99 and max\n";
+	return 1;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+		return PrintUsage();
+
+	std::string command = argv[1];
+	Trace trace;
+	if (command != "json" && command != "stats")
+		return PrintUsage();
+	if (!LoadTrace(argv[2], trace))
+		return 1;
+
+	if (command == "stats")
+		return PrintStats(trace);
+
+	if (argc < 4)
+		return WriteJson(trace, std::cout);
+
+	std::ofstream out(argv[3]);
+	if (!out)
+	{
+		std::cerr << "Could not write '" << argv[3] << "'\n";
+		return 1;
+	}
+	return WriteJson(trace, out);
+}
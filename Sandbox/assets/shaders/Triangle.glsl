@@ -1,10 +1,17 @@
 #type vertex
-#version 330 core
+#version 450 core
 			
 layout(location = 0) in vec3 a_Position;
 layout(location = 1) in vec4 a_Color;
 
-uniform mat4 u_ProjectionView;
+layout(std140, binding = 0) uniform Camera
+{
+	mat4 u_ProjectionView;
+	mat4 u_Projection;
+	mat4 u_View;
+	mat4 u_SkyboxView;
+};
+
 uniform mat4 u_Transform;
 
 out vec4 v_Color;
@@ -16,7 +23,7 @@ void main()
 }
 
 #type fragment
-#version 330 core
+#version 450 core
 
 layout(location = 0) out vec4 color;
 in vec4 v_Color;
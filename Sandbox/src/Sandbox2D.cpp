@@ -12,7 +12,7 @@ Sandbox2D::Sandbox2D()
 void Sandbox2D::OnAttach()
 {
 	HZ_PROFILE_FUNCTION();
-	m_Texture = Hazel::Texture2D::Create("assets/textures/checkerboard.png");
+	m_Texture = Hazel::Texture2D::CreateAsync("assets/textures/checkerboard.png");
 }
 
 void Sandbox2D::OnDetach()
@@ -28,12 +28,44 @@ void Sandbox2D::OnUpdate(Hazel::TimeStep ts)
 
 	Hazel::Renderer2D::BeginScene(m_CameraController.GetCamera());
 	Hazel::Renderer2D::DrawQuad(m_TexturePosition, m_Texture, m_TextureSize, m_TextureColor, 10.0f);
-	Hazel::Renderer2D::DrawRotatedQuad(m_SquarePosition, 3.141f / 4, m_SquareColor, m_SquareSize);
+	// the rotation is simulated at a fixed rate, blend the last two steps for smooth motion
+	float alpha = Hazel::Application::Get().GetFixedUpdateAlpha();
+	float rotation = m_PreviousSquareRotation + (m_SquareRotation - m_PreviousSquareRotation) * alpha;
+	Hazel::Renderer2D::DrawRotatedQuad(m_SquarePosition, rotation, m_SquareColor, m_SquareSize);
+
+	// stress test for the batch renderer
+	for (float y = -5.0f; y < 5.0f; y += 0.5f)
+	{
+		for (float x = -5.0f; x < 5.0f; x += 0.5f)
+		{
+			glm::vec4 color = { (x + 5.0f) / 10.0f, 0.4f, (y + 5.0f) / 10.0f, 0.7f };
+			Hazel::Renderer2D::DrawQuad({ x, y, 0.1f }, color, { 0.45f, 0.45f });
+		}
+	}
 	Hazel::Renderer2D::EndScene();
 }
 
+void Sandbox2D::OnFixedUpdate(Hazel::TimeStep ts)
+{
+	m_PreviousSquareRotation = m_SquareRotation;
+	m_SquareRotation += 1.0f * ts;
+}
+
 void Sandbox2D::OnImGuiRender()
 {
+	ImGui::Begin("Renderer2D Stats");
+
+	auto stats = Hazel::Renderer2D::GetStats();
+	ImGui::Text("Draw Calls: %d", stats.DrawCalls);
+	ImGui::Text("Quads: %d", stats.QuadCount);
+	ImGui::Text("Culled Quads: %d", stats.CulledQuads);
+	ImGui::Text("Vertices: %d", stats.GetTotalVertexCount());
+	ImGui::Text("Indices: %d", stats.GetTotalIndexCount());
+
+	ImGui::End();
+
+	Hazel::ProfilerPanel::OnImGuiRender();
+	Hazel::FrameStatsPanel::OnImGuiRender();
 }
 
 void Sandbox2D::OnEvent(Hazel::Event& e)
@@ -11,6 +11,7 @@ public:
 	virtual void OnDetach() override;
 
 	void OnUpdate(Hazel::TimeStep ts) override;
+	void OnFixedUpdate(Hazel::TimeStep ts) override;
 	virtual void OnImGuiRender() override;
 	void OnEvent(Hazel::Event& e) override;
 private:
@@ -24,6 +25,7 @@ private:
 	glm::vec4 m_SquareColor = glm::vec4(0.8f, 0.3f, 0.2f, 1.0f);
 	glm::vec2 m_SquarePosition = { 0.0f, 0.0f };
 	float m_SquareRotation = 0.0f;
+	float m_PreviousSquareRotation = 0.0f;
 	glm::vec2 m_SquareSize = { 1.0f, 1.0f };
 	
 	glm::vec4 m_TextureColor = glm::vec4(1.0f);
@@ -98,14 +98,11 @@ public:
 
 			auto textureShader = m_ShaderLibrary.Get("Texture");
 
-			m_Texture->Bind(0);
-			Hazel::Renderer::Submit(textureShader, m_SquareVA, glm::scale(glm::mat4(1.0f), glm::vec3(1.0f, 1.0f * m_LogoTexture->GetHeight() / m_LogoTexture->GetWidth(), 1.0f)));
-			m_LogoTexture->Bind(0);
-			Hazel::Renderer::Submit(textureShader, m_SquareVA, glm::scale(glm::mat4(1.0f), glm::vec3(1.0f)));
+			Hazel::Renderer::Submit(textureShader, m_SquareVA, glm::scale(glm::mat4(1.0f), glm::vec3(1.0f, 1.0f * m_LogoTexture->GetHeight() / m_LogoTexture->GetWidth(), 1.0f)), { m_Texture });
+			// the logo has transparent parts, it goes on top of the checkerboard
+			Hazel::Renderer::Submit(textureShader, m_SquareVA, glm::scale(glm::mat4(1.0f), glm::vec3(1.0f)), { m_LogoTexture, glm::vec4(1.0f), true });
 
 
-			m_ShaderLibrary.Get("FlatColor")->Bind();
-
 			for (int x = 0; x < 15; x++)
 			{
 				for (int y = 0; y < 15; y++)
@@ -113,9 +110,7 @@ public:
 					glm::vec3 pos(x * 0.11f, y * 0.11f, 0.0f);
 					glm::mat4 tranform = glm::translate(glm::mat4(1.0f), pos) * scale;
 
-					m_ShaderLibrary.Get("FlatColor")->SetFloat4("u_Color", m_SquareColor);
-
-					Hazel::Renderer::Submit(m_ShaderLibrary.Get("FlatColor"), m_SquareVA, tranform);
+					Hazel::Renderer::Submit(m_ShaderLibrary.Get("FlatColor"), m_SquareVA, tranform, { nullptr, m_SquareColor });
 				}
 			}
 
@@ -150,6 +145,7 @@ public:
 	Sandbox()
 	{
 		GetWindow().SetVSync(false);
+		SetFixedTimeStep(1.0 / 60.0);
 		//PushLayer(new ExampleLayer());
 		PushLayer(new Sandbox2D());
 
@@ -61,8 +61,7 @@ project "Hazel"
 	links {
 		"GLFW",
 		"Glad",
-		"ImGui",
-		"opengl32.lib"
+		"ImGui"
 	}
 
 	filter "system:windows"
@@ -74,6 +73,17 @@ project "Hazel"
 			"GLFW_INCLUDE_NONE"
 		}
 
+		links {
+			"opengl32.lib"
+		}
+
+	-- meant for running --headless, e.g. benchmarks on a machine without a GPU
+	filter "system:linux"
+		defines {
+			"HZ_PLATFORM_LINUX",
+			"GLFW_INCLUDE_NONE"
+		}
+
 	filter "configurations:Debug"
 		defines "HZ_DEBUG"
 		runtime "Debug"
@@ -123,6 +133,18 @@ project "Sandbox"
 			"HZ_PLATFORM_WINDOWS"
 		}
 
+	filter "system:linux"
+		defines {
+			"HZ_PLATFORM_LINUX"
+		}
+
+		links {
+			"GL",
+			"X11",
+			"dl",
+			"pthread"
+		}
+
 	filter "configurations:Debug"
 		defines "HZ_DEBUG"
 		runtime "Debug"
@@ -138,6 +160,38 @@ project "Sandbox"
 		runtime "Release"
 		optimize "on"
 
+project "HazelTrace"
+	location "HazelTrace"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++17"
+	staticruntime "on"
+
+	targetdir ("bin/" .. outputdir .. "/%{prj.name}")
+	objdir ("bin-int/" .. outputdir .. "/%{prj.name}")
+
+	files {
+		"%{prj.name}/src/**.h",
+		"%{prj.name}/src/**.cpp"
+	}
+
+	-- only the standalone Hazel/Debug/TraceFormat.h is used, no link against Hazel
+	includedirs {
+		"Hazel/src"
+	}
+
+	filter "configurations:Debug"
+		runtime "Debug"
+		symbols "on"
+
+	filter "configurations:Release"
+		runtime "Release"
+		optimize "on"
+
+	filter "configurations:Dist"
+		runtime "Release"
+		optimize "on"
+
 
 project "Minecraft"
 	location "Minecraft"